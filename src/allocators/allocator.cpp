@@ -30,6 +30,7 @@
 #include <sstream>
 #include <cassert>
 #include "allocator.hpp"
+#include "misc_utils.hpp"
 
 /////////////////////////////////////////////////////////////////////////
 //Allocator types
@@ -41,6 +42,7 @@
 #include "selalloc.hpp"
 #include "separable_input_first.hpp"
 #include "separable_output_first.hpp"
+#include "separable_flat.hpp"
 //
 /////////////////////////////////////////////////////////////////////////
 
@@ -419,6 +421,172 @@ void SparseAllocator::PrintRequests( ostream * os ) const
   *os << "]." << endl;
 }
 
+//==================================================
+// FlatAllocator
+//==================================================
+
+FlatAllocator::FlatAllocator( Module *parent, const string& name,
+			      int inputs, int outputs ) :
+  Allocator( parent, name, inputs, outputs ),
+  _out_words( mask_words( outputs ) ), _in_words( mask_words( inputs ) ),
+  _num_requests( 0 ), _same_pri( true ), _first_in_pri( 0 ),
+  _first_out_pri( 0 )
+{
+  _in_req.resize(_inputs * _out_words, 0);
+  _out_req.resize(_outputs * _in_words, 0);
+  _in_occ.resize(_in_words, 0);
+  _out_occ.resize(_out_words, 0);
+  _in_num.resize(_inputs, 0);
+  _out_num.resize(_outputs, 0);
+  _request.resize(_inputs * _outputs);
+}
+
+void FlatAllocator::Clear( )
+{
+  if ( _num_requests > 0 ) {
+    for ( int in = mask_first( &_in_occ[0], _in_words, 0 ); in >= 0;
+	  in = mask_first( &_in_occ[0], _in_words, in + 1 ) ) {
+      for ( int w = 0; w < _out_words; ++w ) {
+	_in_req[in * _out_words + w] = 0;
+      }
+      _in_num[in] = 0;
+    }
+    for ( int out = mask_first( &_out_occ[0], _out_words, 0 ); out >= 0;
+	  out = mask_first( &_out_occ[0], _out_words, out + 1 ) ) {
+      for ( int w = 0; w < _in_words; ++w ) {
+	_out_req[out * _in_words + w] = 0;
+      }
+      _out_num[out] = 0;
+    }
+    _in_occ.assign(_in_words, 0);
+    _out_occ.assign(_out_words, 0);
+    _num_requests = 0;
+  }
+  _same_pri = true;
+
+  Allocator::Clear();
+}
+
+int FlatAllocator::ReadRequest( int in, int out ) const
+{
+  assert( ( in >= 0 ) && ( in < _inputs ) );
+  assert( ( out >= 0 ) && ( out < _outputs ) );
+
+  if ( ( _InRow(in)[out >> 6] >> ( out & 63 ) ) & 1 ) {
+    return _request[in * _outputs + out].label;
+  }
+  return -1;
+}
+
+bool FlatAllocator::ReadRequest( sRequest &req, int in, int out ) const
+{
+  assert( ( in >= 0 ) && ( in < _inputs ) );
+  assert( ( out >= 0 ) && ( out < _outputs ) );
+
+  if ( ( _InRow(in)[out >> 6] >> ( out & 63 ) ) & 1 ) {
+    req = _request[in * _outputs + out];
+    return true;
+  }
+  return false;
+}
+
+void FlatAllocator::AddRequest( int in, int out, int label, 
+				int in_pri, int out_pri )
+{
+  Allocator::AddRequest(in, out, label, in_pri, out_pri);
+  assert( ReadRequest( in, out ) < 0 );
+
+  _in_req[in * _out_words + ( out >> 6 )] |= 1ULL << ( out & 63 );
+  _out_req[out * _in_words + ( in >> 6 )] |= 1ULL << ( in & 63 );
+  if ( _in_num[in]++ == 0 ) {
+    _in_occ[in >> 6] |= 1ULL << ( in & 63 );
+  }
+  if ( _out_num[out]++ == 0 ) {
+    _out_occ[out >> 6] |= 1ULL << ( out & 63 );
+  }
+
+  sRequest & req = _request[in * _outputs + out];
+  req.port    = out;
+  req.label   = label;
+  req.in_pri  = in_pri;
+  req.out_pri = out_pri;
+
+  if ( _num_requests == 0 ) {
+    _first_in_pri  = in_pri;
+    _first_out_pri = out_pri;
+  } else if ( ( in_pri != _first_in_pri ) || ( out_pri != _first_out_pri ) ) {
+    _same_pri = false;
+  }
+  ++_num_requests;
+}
+
+void FlatAllocator::RemoveRequest( int in, int out, int label )
+{
+  assert( ( in >= 0 ) && ( in < _inputs ) );
+  assert( ( out >= 0 ) && ( out < _outputs ) ); 
+  assert( ReadRequest( in, out ) == label );
+
+  _in_req[in * _out_words + ( out >> 6 )] &= ~( 1ULL << ( out & 63 ) );
+  _out_req[out * _in_words + ( in >> 6 )] &= ~( 1ULL << ( in & 63 ) );
+  if ( --_in_num[in] == 0 ) {
+    _in_occ[in >> 6] &= ~( 1ULL << ( in & 63 ) );
+  }
+  if ( --_out_num[out] == 0 ) {
+    _out_occ[out >> 6] &= ~( 1ULL << ( out & 63 ) );
+  }
+  --_num_requests;
+}
+
+bool FlatAllocator::InputHasRequests( int in ) const
+{
+  return _in_num[in] > 0;
+}
+
+bool FlatAllocator::OutputHasRequests( int out ) const
+{
+  return _out_num[out] > 0;
+}
+
+int FlatAllocator::NumInputRequests( int in ) const
+{
+  return _in_num[in];
+}
+
+int FlatAllocator::NumOutputRequests( int out ) const
+{
+  return _out_num[out];
+}
+
+void FlatAllocator::PrintRequests( ostream * os ) const
+{
+  if(!os) os = &cout;
+  
+  *os << "Input requests = [ ";
+  for ( int input = 0; input < _inputs; ++input ) {
+    if(_in_num[input] > 0) {
+      *os << input << " -> [ ";
+      for ( int output = mask_first( _InRow(input), _out_words, 0 ); output >= 0;
+	    output = mask_first( _InRow(input), _out_words, output + 1 ) ) {
+	*os << output << "@" << _request[input * _outputs + output].in_pri << " ";
+      }
+      *os << "]  ";
+    }
+  }
+  *os << "], output requests = [ ";
+  for ( int output = 0; output < _outputs; ++output ) {
+    if(_out_num[output] > 0) {
+      *os << output << " -> ";
+      *os << "[ ";
+      for ( int input = mask_first( _OutRow(output), _in_words, 0 ); input >= 0;
+	    input = mask_first( _OutRow(output), _in_words, input + 1 ) ) {
+	*os << input << "@" << _request[input * _outputs + output].out_pri << " ";
+      }
+      *os << "]  ";
+    }
+  }
+  *os << "]." << endl;
+}
+
 //==================================================
 // Global allocator allocation function
 //==================================================
@@ -469,6 +637,21 @@ Allocator *Allocator::NewAllocator( Module *parent, const string& name,
     string arb_type = param_str.empty() ? (config ? config->GetStr("arb_type") : "round_robin") : param_str;
     a = new SeparableOutputFirstAllocator( parent, name, inputs, outputs,
 					   arb_type );
+  } else if ( alloc_name == "flat_islip" ) {
+    int iters = param_str.empty() ? (config ? config->GetInt("alloc_iters") : 1) : atoi(param_str.c_str());
+    a = new iSLIP_Flat( parent, name, inputs, outputs, iters );
+  } else if ( alloc_name == "flat_wavefront" ) {
+    a = new FlatWavefront( parent, name, inputs, outputs );
+  } else if ( alloc_name == "flat_rr_wavefront" ) {
+    a = new FlatWavefront( parent, name, inputs, outputs, true );
+  } else if (alloc_name == "flat_separable_input_first") {
+    string arb_type = param_str.empty() ? (config ? config->GetStr("arb_type") : "round_robin") : param_str;
+    a = new SeparableInputFirstFlatAllocator( parent, name, inputs, outputs,
+					      arb_type );
+  } else if (alloc_name == "flat_separable_output_first") {
+    string arb_type = param_str.empty() ? (config ? config->GetStr("arb_type") : "round_robin") : param_str;
+    a = new SeparableOutputFirstFlatAllocator( parent, name, inputs, outputs,
+					       arb_type );
   }
 
 //==================================================
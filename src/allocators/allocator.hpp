@@ -155,4 +155,65 @@ public:
 
 };
 
+//==================================================
+// A flat allocator stores the request matrix as
+// bit masks per input and per output, so that
+// requests can be matched a word at a time and
+// Clear() only touches the ports with requests.
+//==================================================
+
+class FlatAllocator : public Allocator {
+protected:
+  // words of a mask over the outputs / over the inputs
+  int _out_words;
+  int _in_words;
+
+  // outputs requested by each input, inputs requesting each output
+  vector<unsigned long long> _in_req;
+  vector<unsigned long long> _out_req;
+  // inputs / outputs with at least one request
+  vector<unsigned long long> _in_occ;
+  vector<unsigned long long> _out_occ;
+  vector<int> _in_num;
+  vector<int> _out_num;
+
+  // request data, valid where the mask bit is set
+  vector<sRequest> _request;
+
+  int _num_requests;
+  // every request added since Clear() had the same priorities
+  bool _same_pri;
+  int _first_in_pri;
+  int _first_out_pri;
+
+  const unsigned long long * _InRow( int in ) const {
+    return &_in_req[in * _out_words];
+  }
+  const unsigned long long * _OutRow( int out ) const {
+    return &_out_req[out * _in_words];
+  }
+
+public:
+  FlatAllocator( Module *parent, const string& name,
+		 int inputs, int outputs );
+
+  void Clear( );
+  
+  int  ReadRequest( int in, int out ) const;
+  bool ReadRequest( sRequest &req, int in, int out ) const;
+
+  void AddRequest( int in, int out, int label = 1, 
+		   int in_pri = 0, int out_pri = 0 );
+  void RemoveRequest( int in, int out, int label = 1 );
+  
+  bool OutputHasRequests( int out ) const;
+  bool InputHasRequests( int in ) const;
+
+  int NumOutputRequests( int out ) const;
+  int NumInputRequests( int in ) const;
+
+  void PrintRequests( ostream * os = NULL ) const;
+
+};
+
 #endif
@@ -30,6 +30,7 @@
 
 #include "islip.hpp"
 #include "random_utils.hpp"
+#include "misc_utils.hpp"
 
 //#define DEBUG_ISLIP
 
@@ -181,3 +182,89 @@ void iSLIP_Sparse::Allocate( )
   cout << endl;
 #endif
 }
+
+iSLIP_Flat::iSLIP_Flat( Module *parent, const string& name,
+			int inputs, int outputs, int iters ) :
+  FlatAllocator( parent, name, inputs, outputs ),
+  _iSLIP_iter(iters)
+{
+  _gptrs.resize(_outputs, 0);
+  _aptrs.resize(_inputs, 0);
+  _in_matched.resize(_in_words, 0);
+  _free_req.resize(_in_words, 0);
+  _grants.resize(_inputs * _out_words, 0);
+  _granted.resize(_in_words, 0);
+}
+
+void iSLIP_Flat::Allocate( )
+{
+  if ( _num_requests == 0 ) {
+    return;
+  }
+
+  _in_matched.assign(_in_words, 0);
+
+  for ( int iter = 0; iter < _iSLIP_iter; ++iter ) {
+    // Grant phase: every free output grants the first free input
+    // requesting it, starting at its pointer
+
+    for ( int output = mask_first( &_out_occ[0], _out_words, 0 ); output >= 0;
+	  output = mask_first( &_out_occ[0], _out_words, output + 1 ) ) {
+
+      if ( _outmatch[output] != -1 ) {
+	continue;
+      }
+
+      const unsigned long long * req = _OutRow(output);
+      for ( int w = 0; w < _in_words; ++w ) {
+	_free_req[w] = req[w] & ~_in_matched[w];
+      }
+      int const input = mask_first_wrap( &_free_req[0], _in_words,
+					 _gptrs[output] );
+      if ( input >= 0 ) {
+	_grants[input * _out_words + ( output >> 6 )] |= 1ULL << ( output & 63 );
+	_granted[input >> 6] |= 1ULL << ( input & 63 );
+      }
+    }
+
+    // Accept phase: every granted input accepts the first grant,
+    // starting at its pointer
+
+    for ( int input = mask_first( &_granted[0], _in_words, 0 ); input >= 0;
+	  input = mask_first( &_granted[0], _in_words, input + 1 ) ) {
+
+      unsigned long long * grants = &_grants[input * _out_words];
+      int const output = mask_first_wrap( grants, _out_words, _aptrs[input] );
+      assert( output >= 0 );
+
+      _inmatch[input]   = output;
+      _outmatch[output] = input;
+      _in_matched[input >> 6] |= 1ULL << ( input & 63 );
+
+      // Only update pointers if accepted during the 1st iteration
+      if ( iter == 0 ) {
+	_gptrs[output] = ( input + 1 ) % _inputs;
+	_aptrs[input]  = ( output + 1 ) % _outputs;
+      }
+
+      for ( int w = 0; w < _out_words; ++w ) {
+	grants[w] = 0;
+      }
+    }
+    _granted.assign(_in_words, 0);
+  }
+
+#ifdef DEBUG_ISLIP
+  cout << "input match: ";
+  for ( int i = 0; i < _inputs; ++i ) {
+    cout << _inmatch[i] << " ";
+  }
+  cout << endl;
+
+  cout << "output match: ";
+  for ( int j = 0; j < _outputs; ++j ) {
+    cout << _outmatch[j] << " ";
+  }
+  cout << endl;
+#endif
+}
@@ -45,4 +45,26 @@ public:
   void Allocate( );
 };
 
+// iSLIP on the bit masks of a FlatAllocator: each grant and accept is a
+// round-robin search of one mask word by word
+class iSLIP_Flat : public FlatAllocator {
+  int _iSLIP_iter;
+
+  vector<int> _gptrs;
+  vector<int> _aptrs;
+
+  // inputs matched so far, scratch for the free requesting inputs
+  vector<unsigned long long> _in_matched;
+  vector<unsigned long long> _free_req;
+  // outputs granting each input, inputs with at least one grant
+  vector<unsigned long long> _grants;
+  vector<unsigned long long> _granted;
+
+public:
+  iSLIP_Flat( Module *parent, const string& name,
+	      int inputs, int outputs, int iters );
+
+  void Allocate( );
+};
+
 #endif 
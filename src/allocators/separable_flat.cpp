@@ -0,0 +1,195 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ----------------------------------------------------------------------
+//
+//  SeparableFlatAllocator: Separable Allocators on Request Bit Masks
+//
+// ----------------------------------------------------------------------
+
+#include "separable_flat.hpp"
+
+#include "booksim.hpp"
+#include "misc_utils.hpp"
+
+#include <algorithm>
+
+SeparableFlatAllocator::
+SeparableFlatAllocator( Module* parent, const string& name, int inputs,
+			int outputs, const string& arb_type )
+  : FlatAllocator( parent, name, inputs, outputs )
+{
+  if ( arb_type != "round_robin" ) {
+    Error( "Flat separable allocators only support round_robin arbiters, not " +
+	   arb_type );
+  }
+  _input_ptr.resize(inputs, 0);
+  _output_ptr.resize(outputs, 0);
+  _stage.resize(max(inputs * _in_words, outputs * _out_words), 0);
+  _stage_occ.resize(max(_in_words, _out_words), 0);
+}
+
+// the request with the highest priority wins, ties are broken in
+// round-robin order from the pointer (as RoundRobinArbiter)
+
+int SeparableFlatAllocator::_InputArbitrate( int input,
+					     const unsigned long long * req ) const
+{
+  int const ptr = _input_ptr[input];
+  int best = mask_first_wrap( req, _out_words, ptr );
+  if ( _same_pri || ( best < 0 ) ) {
+    return best;
+  }
+  int best_pri = _request[input * _outputs + best].in_pri;
+  int const first = best;
+  for ( int output = mask_first_wrap( req, _out_words, first + 1 ); output != first;
+	output = mask_first_wrap( req, _out_words, output + 1 ) ) {
+    int const pri = _request[input * _outputs + output].in_pri;
+    if ( pri > best_pri ) {
+      best = output;
+      best_pri = pri;
+    }
+  }
+  return best;
+}
+
+int SeparableFlatAllocator::_OutputArbitrate( int output,
+					      const unsigned long long * req ) const
+{
+  int const ptr = _output_ptr[output];
+  int best = mask_first_wrap( req, _in_words, ptr );
+  if ( _same_pri || ( best < 0 ) ) {
+    return best;
+  }
+  int best_pri = _request[best * _outputs + output].out_pri;
+  int const first = best;
+  for ( int input = mask_first_wrap( req, _in_words, first + 1 ); input != first;
+	input = mask_first_wrap( req, _in_words, input + 1 ) ) {
+    int const pri = _request[input * _outputs + output].out_pri;
+    if ( pri > best_pri ) {
+      best = input;
+      best_pri = pri;
+    }
+  }
+  return best;
+}
+
+void SeparableFlatAllocator::_Grant( int input, int output )
+{
+  assert((_inmatch[input] == -1) && (_outmatch[output] == -1));
+
+  _inmatch[input] = output;
+  _outmatch[output] = input;
+  _input_ptr[input] = ( output + 1 ) % _outputs;
+  _output_ptr[output] = ( input + 1 ) % _inputs;
+}
+
+// ----------------------------------------------------------------------
+//
+//  SeparableInputFirstFlatAllocator
+//
+// ----------------------------------------------------------------------
+
+SeparableInputFirstFlatAllocator::
+SeparableInputFirstFlatAllocator( Module* parent, const string& name,
+				  int inputs, int outputs,
+				  const string& arb_type )
+  : SeparableFlatAllocator( parent, name, inputs, outputs, arb_type )
+{}
+
+void SeparableInputFirstFlatAllocator::Allocate() {
+
+  if ( _num_requests == 0 ) {
+    return;
+  }
+
+  // Execute the input arbiters and forward the grants to the output
+  // arbiters.
+
+  for ( int input = mask_first( &_in_occ[0], _in_words, 0 ); input >= 0;
+	input = mask_first( &_in_occ[0], _in_words, input + 1 ) ) {
+    int const output = _InputArbitrate( input, _InRow(input) );
+    assert( output > -1 );
+    _stage[output * _in_words + ( input >> 6 )] |= 1ULL << ( input & 63 );
+    _stage_occ[output >> 6] |= 1ULL << ( output & 63 );
+  }
+
+  // Execute the output arbiters.
+
+  for ( int output = mask_first( &_stage_occ[0], _out_words, 0 ); output >= 0;
+	output = mask_first( &_stage_occ[0], _out_words, output + 1 ) ) {
+    unsigned long long * req = &_stage[output * _in_words];
+    _Grant( _OutputArbitrate( output, req ), output );
+    for ( int w = 0; w < _in_words; ++w ) {
+      req[w] = 0;
+    }
+  }
+  _stage_occ.assign(_stage_occ.size( ), 0);
+}
+
+// ----------------------------------------------------------------------
+//
+//  SeparableOutputFirstFlatAllocator
+//
+// ----------------------------------------------------------------------
+
+SeparableOutputFirstFlatAllocator::
+SeparableOutputFirstFlatAllocator( Module* parent, const string& name,
+				   int inputs, int outputs,
+				   const string& arb_type )
+  : SeparableFlatAllocator( parent, name, inputs, outputs, arb_type )
+{}
+
+void SeparableOutputFirstFlatAllocator::Allocate() {
+
+  if ( _num_requests == 0 ) {
+    return;
+  }
+
+  // Execute the output arbiters and forward the grants to the input
+  // arbiters.
+
+  for ( int output = mask_first( &_out_occ[0], _out_words, 0 ); output >= 0;
+	output = mask_first( &_out_occ[0], _out_words, output + 1 ) ) {
+    int const input = _OutputArbitrate( output, _OutRow(output) );
+    assert( input > -1 );
+    _stage[input * _out_words + ( output >> 6 )] |= 1ULL << ( output & 63 );
+    _stage_occ[input >> 6] |= 1ULL << ( input & 63 );
+  }
+
+  // Execute the input arbiters.
+
+  for ( int input = mask_first( &_stage_occ[0], _in_words, 0 ); input >= 0;
+	input = mask_first( &_stage_occ[0], _in_words, input + 1 ) ) {
+    unsigned long long * req = &_stage[input * _out_words];
+    _Grant( input, _InputArbitrate( input, req ) );
+    for ( int w = 0; w < _out_words; ++w ) {
+      req[w] = 0;
+    }
+  }
+  _stage_occ.assign(_stage_occ.size( ), 0);
+}
@@ -27,34 +27,69 @@
 
 // ----------------------------------------------------------------------
 //
-//  SeparableAllocator: Separable Allocator Base Class
+//  SeparableFlatAllocator: Separable Allocators on Request Bit Masks
+//
+//  The round-robin arbiters are kept as pointers of the allocator. When
+//  all requests share one priority an arbiter is a round-robin search of
+//  its request mask word by word; otherwise only the requesting ports are
+//  visited.
 //
 // ----------------------------------------------------------------------
 
-#ifndef _SEPARABLE_HPP_
-#define _SEPARABLE_HPP_
+#ifndef _SEPARABLE_FLAT_HPP_
+#define _SEPARABLE_FLAT_HPP_
 
 #include <vector>
 
 #include "allocator.hpp"
 
-class Arbiter;
-
-class SeparableAllocator : public SparseAllocator {
+class SeparableFlatAllocator : public FlatAllocator {
   
 protected:
 
-  vector<Arbiter*> _input_arb ;
-  vector<Arbiter*> _output_arb ;
+  // round-robin pointers of the input and output arbiters
+  vector<int> _input_ptr;
+  vector<int> _output_ptr;
+
+  // requests forwarded by the first arbitration stage, one mask per
+  // port of the second stage, and the ports of the second stage that
+  // received any
+  vector<unsigned long long> _stage;
+  vector<unsigned long long> _stage_occ;
+
+  int _InputArbitrate( int input, const unsigned long long * req ) const;
+  int _OutputArbitrate( int output, const unsigned long long * req ) const;
+
+  void _Grant( int input, int output );
 
 public:
   
-  SeparableAllocator( Module* parent, const string& name, int inputs,
-		      int outputs, const string& arb_type ) ;
+  SeparableFlatAllocator( Module* parent, const string& name, int inputs,
+			  int outputs, const string& arb_type ) ;
+
+} ;
+
+class SeparableInputFirstFlatAllocator : public SeparableFlatAllocator {
+
+public:
+  
+  SeparableInputFirstFlatAllocator( Module* parent, const string& name,
+				    int inputs, int outputs,
+				    const string& arb_type ) ;
+
+  virtual void Allocate() ;
+
+} ;
+
+class SeparableOutputFirstFlatAllocator : public SeparableFlatAllocator {
+
+public:
   
-  virtual ~SeparableAllocator() ;
+  SeparableOutputFirstFlatAllocator( Module* parent, const string& name,
+				     int inputs, int outputs,
+				     const string& arb_type ) ;
 
-  virtual void Clear() ;
+  virtual void Allocate() ;
 
 } ;
 
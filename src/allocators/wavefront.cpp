@@ -32,6 +32,8 @@
  */
 #include "booksim.hpp"
 
+#include <algorithm>
+
 #include "wavefront.hpp"
 
 Wavefront::Wavefront( Module *parent, const string& name,
@@ -109,3 +111,100 @@ void Wavefront::Allocate( )
 }
 
 
+
+FlatWavefront::FlatWavefront( Module *parent, const string& name,
+			      int inputs, int outputs, bool skip_diags ) :
+  FlatAllocator( parent, name, inputs, outputs ),
+  _last_in(-1), _last_out(-1), _skip_diags(skip_diags), 
+  _square(max(inputs, outputs)), _pri(0)
+{
+  _diag_req.resize(_square);
+}
+
+void FlatWavefront::Clear( )
+{
+  for ( size_t i = 0; i < _used_diags.size( ); ++i ) {
+    _diag_req[_used_diags[i]].clear( );
+  }
+  _used_diags.clear( );
+  _priorities.clear( );
+  _last_in = -1;
+  _last_out = -1;
+  FlatAllocator::Clear( );
+}
+
+void FlatWavefront::AddRequest( int in, int out, int label, 
+				int in_pri, int out_pri )
+{
+  FlatAllocator::AddRequest(in, out, label, in_pri, out_pri);
+  _last_in = in;
+  _last_out = out;
+  if ( _priorities.empty( ) || 
+       ( _priorities.back( ) != make_pair(out_pri, in_pri) ) ) {
+    _priorities.push_back(make_pair(out_pri, in_pri));
+  }
+  vector<int> & diag = _diag_req[( in + out ) % _square];
+  if ( diag.empty( ) ) {
+    _used_diags.push_back(( in + out ) % _square);
+  }
+  diag.push_back(in * _outputs + out);
+}
+
+void FlatWavefront::Allocate( )
+{
+
+  int first_diag = -1;
+
+  if(_num_requests == 0)
+
+    // bypass allocator completely if there were no requests
+    return;
+  
+  if((_num_requests == 1) && (ReadRequest(_last_in, _last_out) != -1)) {
+
+    // if we only had a single request, we can immediately grant it
+    _inmatch[_last_in] = _last_out;
+    _outmatch[_last_out] = _last_in;
+    first_diag = _last_in + _last_out;
+
+  } else {
+
+    // otherwise we have to loop through the diagonals of request matrix,
+    // from the highest priority down
+
+    sort(_priorities.begin( ), _priorities.end( ));
+    _priorities.erase(unique(_priorities.begin( ), _priorities.end( )),
+		      _priorities.end( ));
+
+    for(vector<pair<int, int> >::const_reverse_iterator iter = 
+	  _priorities.rbegin();
+	iter != _priorities.rend(); ++iter) {
+      
+      for ( int p = 0; p < _square; ++p ) {
+	// the requests of a diagonal share no input and no output
+	vector<int> const & diag = _diag_req[( _pri + p ) % _square];
+	for ( size_t i = 0; i < diag.size( ); ++i ) {
+	  int const input = diag[i] / _outputs;
+	  int const output = diag[i] % _outputs;
+	  sRequest const & req = _request[diag[i]];
+	  if ( ( _inmatch[input] == -1 ) && ( _outmatch[output] == -1 ) &&
+	       ( ReadRequest( input, output ) != -1 ) &&
+	       ( req.in_pri == iter->second ) &&
+	       ( req.out_pri == iter->first ) ) {
+	    // Grant!
+	    _inmatch[input] = output;
+	    _outmatch[output] = input;
+	    if(first_diag < 0) {
+	      first_diag = input + output;
+	    }
+	  }
+	}
+      }
+    }
+  }
+
+  assert(first_diag >= 0);
+
+  // Round-robin the priority diagonal
+  _pri = ( ( _skip_diags ? first_diag : _pri ) + 1 ) % _square;
+}
@@ -29,6 +29,7 @@
 #define _WAVEFRONT_HPP_
 
 #include <set>
+#include <vector>
 
 #include "allocator.hpp"
 
@@ -54,4 +55,34 @@ public:
   virtual void Allocate( );
 };
 
+// Wavefront allocator on a FlatAllocator: the requests are bucketed by
+// diagonal when they are added, so a pass over the diagonals only visits
+// the requests instead of the whole square matrix
+class FlatWavefront : public FlatAllocator {
+
+private:
+  int _last_in;
+  int _last_out;
+  // distinct ( out_pri, in_pri ) pairs of the requests
+  vector<pair<int, int> > _priorities;
+  bool _skip_diags;
+
+  // requests on each diagonal ( in + out ) % _square, as in * _outputs + out
+  vector<vector<int> > _diag_req;
+  vector<int> _used_diags;
+
+protected:
+  int _square;
+  int _pri;
+
+public:
+  FlatWavefront( Module *parent, const string& name,
+		 int inputs, int outputs, bool skip_diags = false );
+  
+  virtual void Clear( );
+  virtual void AddRequest( int in, int out, int label = 1, 
+			   int in_pri = 0, int out_pri = 0 );
+  virtual void Allocate( );
+};
+
 #endif
@@ -43,23 +43,33 @@ using namespace std ;
 
 Arbiter::Arbiter( Module *parent, const string &name, int size )
   : Module( parent, name ),
-    _size(size), _selected(-1), _highest_pri(numeric_limits<int>::min()),
-    _best_input(-1), _num_reqs(0)
+    _size(size), _words(mask_words(size)), _selected(-1),
+    _highest_pri(numeric_limits<int>::min()), _num_reqs(0)
 {
   _request.resize(size);
-  for ( int i = 0 ; i < size ; i++ ) 
-    _request[i].valid = false ;
+  _valid.resize(_words, 0);
+  _top.resize(_words, 0);
 }
 
 void Arbiter::AddRequest( int input, int id, int pri )
 {
   assert( 0 <= input && input < _size ) ;
-  assert( !_request[input].valid );
+  assert( !_IsValid(input) );
+
+  unsigned long long const bit = 1ULL << ( input & 63 ) ;
 
   _num_reqs++ ;
-  _request[input].valid = true ;
+  _valid[input >> 6] |= bit ;
   _request[input].id = id ;
   _request[input].pri = pri ;
+
+  if ( ( _num_reqs == 1 ) || ( pri > _highest_pri ) ) {
+    _top.assign(_words, 0) ;
+    _highest_pri = pri ;
+  }
+  if ( pri == _highest_pri ) {
+    _top[input >> 6] |= bit ;
+  }
 }
 
 int Arbiter::Arbitrate( int* id, int* pri )
@@ -80,11 +90,12 @@ void Arbiter::Clear()
 {
   if(_num_reqs > 0) {
     
-    // clear the request vector
-    for ( int i = 0; i < _size ; i++ )
-      _request[i].valid = false ;
+    // clear the request masks
+    _valid.assign(_words, 0) ;
+    _top.assign(_words, 0) ;
     _num_reqs = 0 ;
     _selected = -1;
+    _highest_pri = numeric_limits<int>::min();
   }
 }
 
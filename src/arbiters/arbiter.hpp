@@ -37,23 +37,32 @@
 #include <vector>
 
 #include "module.hpp"
+#include "misc_utils.hpp"
 
 class Arbiter : public Module {
 
 protected:
 
   typedef struct { 
-    bool valid ;
     int id ;
     int pri ;
   } entry_t ;
   
   vector<entry_t> _request ;
   int  _size ;
+  int  _words ;
+
+  // inputs with a request, and the inputs whose request has the highest
+  // priority so far
+  vector<unsigned long long> _valid ;
+  vector<unsigned long long> _top ;
 
   int  _selected ;
   int _highest_pri;
-  int _best_input;
+
+  inline bool _IsValid( int input ) const {
+    return ( _valid[input >> 6] >> ( input & 63 ) ) & 1 ;
+  }
 
 public:
   int  _num_reqs ;
@@ -37,20 +37,20 @@ using namespace std ;
 
 MatrixArbiter::MatrixArbiter( Module *parent, const string &name, int size )
   : Arbiter( parent, name, size ), _last_req(-1) {
-  _matrix.resize(size);
+  _matrix.resize(size * _words, 0);
   for ( int i = 0 ; i < size ; i++ ) {
-    _matrix[i].resize(size);
     for ( int j = 0; j < i; j++ ) {
-      _matrix[i][j] = 1;
+      _matrix[i * _words + ( j >> 6 )] |= 1ULL << ( j & 63 );
     }
   }
+  _beaten.resize(_words, 0);
 }
 
 void MatrixArbiter::PrintState() const  {
   cout << "Priority Matrix: " << endl ;
   for ( int r = 0; r < _size ; r++ ) {
     for ( int c = 0 ; c < _size ; c++ ) {
-      cout << _matrix[r][c] << " " ;
+      cout << ( ( _matrix[r * _words + ( c >> 6 )] >> ( c & 63 ) ) & 1 ) << " " ;
     }
     cout << endl ;
   }
@@ -60,11 +60,12 @@ void MatrixArbiter::PrintState() const  {
 void MatrixArbiter::UpdateState() {
   // update priority matrix using last grant
   if ( _selected > -1 ) {
+    unsigned long long const bit = 1ULL << ( _selected & 63 ) ;
     for ( int i = 0; i < _size ; i++ ) {
-      if( _selected != i ) {
-	_matrix[_selected][i] = 0 ;
-	_matrix[i][_selected] = 1 ;
-      }
+      _matrix[i * _words + ( _selected >> 6 )] |= bit ;
+    }
+    for ( int w = 0; w < _words ; w++ ) {
+      _matrix[_selected * _words + w] = 0 ;
     }
   }
 }
@@ -85,30 +86,19 @@ int MatrixArbiter::Arbitrate( int* id, int* pri ) {
     
   } else {
     
-    _selected = -1 ;
-
-    for ( int input = 0 ; input < _size ; input++ ) {
-      if(_request[input].valid) {
-	
-	bool grant = true;
-	for ( int i = 0 ; i < _size ; i++ ) {
-	  if ( _request[i].valid &&
-	       ( ( ( _request[i].pri == _request[input].pri ) &&
-		   _matrix[i][input]) ||
-		 ( _request[i].pri > _request[input].pri )
-		 ) ) {
-	    grant = false ;
-	    break ;
-	  }
-	}
-	
-	if ( grant ) {
-	  _selected = input ;
-	  break ; 
-	}
+    // requests below the highest priority lose; among the others, the
+    // first one that no other top-priority request wins against is granted
+    _beaten.assign(_words, 0) ;
+    for ( int i = mask_first( &_top[0], _words, 0 ) ; i >= 0 ;
+	  i = mask_first( &_top[0], _words, i + 1 ) ) {
+      for ( int w = 0 ; w < _words ; w++ ) {
+	_beaten[w] |= _matrix[i * _words + w] ;
       }
-      
     }
+    for ( int w = 0 ; w < _words ; w++ ) {
+      _beaten[w] = _top[w] & ~_beaten[w] ;
+    }
+    _selected = mask_first( &_beaten[0], _words, 0 ) ;
   }
     
   return Arbiter::Arbitrate(id, pri);
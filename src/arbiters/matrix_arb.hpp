@@ -42,8 +42,10 @@ using namespace std;
 
 class MatrixArbiter : public Arbiter {
 
-  // Priority matrix
-  vector<vector<int> > _matrix ;
+  // Priority matrix: row i is the mask of the inputs i wins against
+  vector<unsigned long long> _matrix ;
+  // inputs beaten by a top-priority request (scratch)
+  vector<unsigned long long> _beaten ;
 
   int  _last_req ;
 
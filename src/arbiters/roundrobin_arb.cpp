@@ -33,7 +33,6 @@
 
 #include "roundrobin_arb.hpp"
 #include <iostream>
-#include <limits>
 
 using namespace std ;
 
@@ -53,28 +52,11 @@ void RoundRobinArbiter::UpdateState() {
     _pointer = ( _selected + 1 ) % _size ;
 }
 
-void RoundRobinArbiter::AddRequest( int input, int id, int pri )
-{
-  if(!_request[input].valid || (_request[input].pri < pri)) {
-    if((_num_reqs == 0) || 
-       Supersedes(input, pri, _best_input, _highest_pri, _pointer,_size )) {
-      _highest_pri = pri;
-      _best_input = input;
-    }
-  }
-  Arbiter::AddRequest(input, id, pri);
-}
-
 int RoundRobinArbiter::Arbitrate( int* id, int* pri ) {
   
-  _selected = _best_input;
+  // the first request of the highest priority in round-robin order from
+  // the pointer, i.e. the lowest bit of the top mask rotated by the pointer
+  _selected = _num_reqs ? mask_first_wrap( &_top[0], _words, _pointer ) : -1;
   
   return Arbiter::Arbitrate(id, pri);
 }
-
-void RoundRobinArbiter::Clear()
-{
-  _highest_pri = numeric_limits<int>::min();
-  _best_input = -1;
-  Arbiter::Clear();
-}
@@ -56,10 +56,6 @@ public:
   // updates pointers to metadata when valid pointers are passed
   virtual int Arbitrate( int* id = 0, int* pri = 0) ;
 
-  virtual void AddRequest( int input, int id, int pri ) ;
-
-  virtual void Clear();
-
   static inline bool Supersedes(int input1, int pri1, int input2, int pri2, int offset, int size)
   {
     // in a round-robin scheme with the given number of positions and current 
@@ -52,11 +52,32 @@ BookSimConfig::BookSimConfig( )
   _int_map["k"] = 8; //network radix
   _int_map["n"] = 2; //network dimension
   _int_map["c"] = 1; //concentration
+  _int_map["hypercubeport"] = -1; //polarfly+ hypercube ports, -1: k
+  _int_map["polarflyport"] = -1; //polarfly+ polarfly ports, -1: n
+  _int_map["nic"] = 1; //nodes per router (polarflyplus, mesh, torus)
   AddStrField( "routing_function", "none" );
+  AddStrField( "pfp_route_table", "group" ); // polarfly+ source routes: group, full or none
+  AddStrField( "pfp_minimal_route", "best" ); // polarfly+ minimal path: best or first found
+  AddStrField( "polarfly_table", "auto" ); // auto, er or a table file
+
+  //===== collective ============================
+  AddStrField( "collective", "" ); // pairwise, ring or none; empty follows the traffic pattern
+  _int_map["single_switch"] = 0; // every node on router 0 (single-tier fat-tree)
+  _int_map["max_step"] = 0; // step-up table size, 0 picks it for the algorithm; at least the steps of a schedule
+  _int_map["collective_threshold"] = 1; // packets per step and NIC
+  _int_map["delay_threshold"] = 100; // start delays are drawn from [0, delay_threshold)
+  _int_map["seq"] = 3; // sample periods per step that have to converge
+  _int_map["chunk"] = 32; // ring: packets of the vector, split over the nodes
 
   //simulator tries to correclty adjust latency for node/router placement 
   _int_map["use_noc_latency"] = 1;
 
+  //channel latencies of fattree, mesh/torus and polarflyplus, 0 keeps the
+  //topology default
+  _int_map["channel_latency"] = 0;
+  _int_map["nic_latency"] = 0; // injection and ejection channels
+  _int_map["dragonfly_latency"] = 0; // 1: 10 cycles local, 100 cycles global
+
 
   //used for noc latency calcualtion for network with concentration
   _int_map["x"] = 8; //number of routers in X
@@ -81,6 +102,7 @@ BookSimConfig::BookSimConfig( )
   //==== General options ===================================
 
   AddStrField( "router", "iq" ); 
+  _int_map["iq_fixed_shape"] = 1; // with -DIQ_FIXED_SHAPES, iq routers of the common shapes use fixed port and VC counts
 
   _int_map["output_delay"] = 0;
   _int_map["credit_delay"] = 0;
@@ -129,6 +151,8 @@ BookSimConfig::BookSimConfig( )
 
   _int_map["hold_switch_for_packet"] = 0; // hold a switch config for the entire packet
 
+  _int_map["flit_train"] = 0; // >1: body flits travel as trains of up to this many flits
+
   _int_map["input_speedup"]     = 1;  // expansion of input ports into crossbar
   _int_map["output_speedup"]    = 1;  // expansion of output ports into crossbar
 
@@ -225,8 +249,10 @@ BookSimConfig::BookSimConfig( )
   // types:
   //   latency    - average + latency distribution for a particular injection rate
   //   throughput - sustained throughput for a particular injection rate
+  //   flow       - max-min fair flow model of a collective, no flits
 
   AddStrField( "sim_type", "latency" );
+  _float_map["flow_cycle_ns"] = 1.0; // flow: cycle time for the times in ms
 
   _int_map["warmup_periods"] = 3; // number of samples periods to "warm-up" the simulation
 
@@ -267,6 +293,18 @@ BookSimConfig::BookSimConfig( )
 
   _int_map["seed"]            = 0; //random seed for simulation, e.g. traffic 
   AddStrField("seed", ""); // workaround to allow special "time" value
+  AddStrField("rng", "knuth"); // knuth: one generator, stream: a counter-based stream per user
+
+  _int_map["threads"] = 1; //threads evaluating the routers and channels of a network
+
+  // parameter sweep: the network is built once and every point runs in a
+  // process of its own, see sweep.hpp
+  AddStrField("sweep_injection_rate", ""); // e.g. {0.1,0.2}; empty: injection_rate
+  AddStrField("sweep_packet_size", ""); // empty: packet_size
+  AddStrField("sweep_seed", ""); // empty: seed
+  _int_map["sweep_jobs"] = 1; // points simulated at the same time
+  AddStrField("sweep_out", "sweep.csv"); // one line of results per point
+  _int_map["sweep_log"] = 0; // 1: output of every point in <sweep_out>.<point>.log
 
   _int_map["print_activity"] = 0;
 
@@ -286,6 +324,8 @@ BookSimConfig::BookSimConfig( )
 
   AddStrField("stats_out", "");
 
+  AddStrField("event_trace_out", ""); // binary flit event trace, see utils/eventtrace.py
+
 #ifdef TRACK_FLOWS
   AddStrField("injected_flits_out", "");
   AddStrField("received_flits_out", "");
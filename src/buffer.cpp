@@ -65,13 +65,14 @@ Buffer::~Buffer()
 
 void Buffer::AddFlit( int vc, Flit *f )
 {
-  if(_occupancy >= _size) {
+  // a train takes one slot per flit it stands for
+  if(_occupancy + f->train > _size) {
     Error("Flit buffer overflow.");
   }
-  ++_occupancy;
+  _occupancy += f->train;
   _vc[vc]->AddFlit(f);
 #ifdef TRACK_BUFFERS
-  ++_class_occupancy[f->cl];
+  _class_occupancy[f->cl] += f->train;
 #endif
 }
 
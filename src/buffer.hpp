@@ -57,11 +57,12 @@ public:
 
   inline Flit *RemoveFlit( int vc )
   {
-    --_occupancy;
+    Flit const * const f = _vc[vc]->FrontFlit( );
+    assert(f);
+    _occupancy -= f->train;
 #ifdef TRACK_BUFFERS
-    int cl = _vc[vc]->FrontFlit()->cl;
-    assert(_class_occupancy[cl] > 0);
-    --_class_occupancy[cl];
+    assert(_class_occupancy[f->cl] >= f->train);
+    _class_occupancy[f->cl] -= f->train;
 #endif
     return _vc[vc]->RemoveFlit( );
   }
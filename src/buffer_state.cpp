@@ -540,6 +540,11 @@ BufferState::BufferState( const Configuration& config, Module *parent, const str
   Module( parent, name ), _occupancy(0)
 {
   _vcs = config.GetInt( "num_vcs" );
+  if(_vcs > VCMask::max_vcs) {
+    ostringstream err;
+    err << "num_vcs exceeds the " << VCMask::max_vcs << " VCs a credit can carry";
+    Error( err.str() );
+  }
   _size = config.GetInt("buf_size");
   if(_size < 0) {
     _size = _vcs * config.GetInt("vc_buf_size");
@@ -573,46 +578,44 @@ void BufferState::ProcessCredit( Credit const * const c )
 {
   assert( c );
 
-  set<int>::iterator iter = c->vc.begin();
-  while(iter != c->vc.end()) {
-
-    int const vc = *iter;
+  for(int vc = c->vc.First(); vc >= 0; vc = c->vc.Next(vc)) {
 
     assert( ( vc >= 0 ) && ( vc < _vcs ) );
 
-    if ( ( _wait_for_tail_credit ) && 
-	 ( _in_use_by[vc] < 0 ) ) {
-      ostringstream err;
-      err << "Received credit for idle VC " << vc;
-      Error( err.str() );
-    }
-    --_occupancy;
-    if(_occupancy < 0) {
-      Error("Buffer occupancy fell below zero.");
-    }
-    --_vc_occupancy[vc];
-    if(_vc_occupancy[vc] < 0) {
-      ostringstream err;
-      err << "Buffer occupancy fell below zero for VC " << vc;
-      Error(err.str());
-    }
-    if(_wait_for_tail_credit && !_vc_occupancy[vc] && _tail_sent[vc]) {
-      assert(_in_use_by[vc] >= 0);
-      _in_use_by[vc] = -1;
-    }
+    for ( int i = 0; i < c->train; ++i ) {
+
+      if ( ( _wait_for_tail_credit ) && 
+	   ( _in_use_by[vc] < 0 ) ) {
+	ostringstream err;
+	err << "Received credit for idle VC " << vc;
+	Error( err.str() );
+      }
+      --_occupancy;
+      if(_occupancy < 0) {
+	Error("Buffer occupancy fell below zero.");
+      }
+      --_vc_occupancy[vc];
+      if(_vc_occupancy[vc] < 0) {
+	ostringstream err;
+	err << "Buffer occupancy fell below zero for VC " << vc;
+	Error(err.str());
+      }
+      if(_wait_for_tail_credit && !_vc_occupancy[vc] && _tail_sent[vc]) {
+	assert(_in_use_by[vc] >= 0);
+	_in_use_by[vc] = -1;
+      }
 
 #ifdef TRACK_BUFFERS
-    assert(!_outstanding_classes[vc].empty());
-    int cl = _outstanding_classes[vc].front();
-    _outstanding_classes[vc].pop();
-    assert((cl >= 0) && (cl < _classes));
-    assert(_class_occupancy[cl] > 0);
-    --_class_occupancy[cl];
+      assert(!_outstanding_classes[vc].empty());
+      int cl = _outstanding_classes[vc].front();
+      _outstanding_classes[vc].pop();
+      assert((cl >= 0) && (cl < _classes));
+      assert(_class_occupancy[cl] > 0);
+      --_class_occupancy[cl];
 #endif
 
-    _buffer_policy->FreeSlotFor(vc);
-
-    ++iter;
+      _buffer_policy->FreeSlotFor(vc);
+    }
   }
 }
 
@@ -623,19 +626,24 @@ void BufferState::SendingFlit( Flit const * const f )
 
   assert( f && ( vc >= 0 ) && ( vc < _vcs ) );
 
-  ++_occupancy;
-  if(_occupancy > _size) {
-    Error("Buffer overflow.");
-  }
+  // a train takes one slot per flit it stands for; it is never a tail, so
+  // the policies see it as that many body flits
+  for ( int i = 0; i < f->train; ++i ) {
 
-  ++_vc_occupancy[vc];
+    ++_occupancy;
+    if(_occupancy > _size) {
+      Error("Buffer overflow.");
+    }
+
+    ++_vc_occupancy[vc];
   
-  _buffer_policy->SendingFlit(f);
+    _buffer_policy->SendingFlit(f);
   
 #ifdef TRACK_BUFFERS
-  _outstanding_classes[vc].push(f->cl);
-  ++_class_occupancy[f->cl];
+    _outstanding_classes[vc].push(f->cl);
+    ++_class_occupancy[f->cl];
 #endif
+  }
 
   if ( f->tail ) {
     _tail_sent[vc] = true;
@@ -198,6 +198,12 @@ public:
   inline bool IsFullFor( int vc = 0 ) const {
     return _buffer_policy->IsFullFor(vc);
   }
+  // true if vc has no room for all the flits of f (see Flit::train)
+  inline bool IsFullFor( int vc, Flit const * const f ) const {
+    return ( f->train > 1 ) ?
+      ( _buffer_policy->AvailableFor(vc) < f->train ) :
+      _buffer_policy->IsFullFor(vc);
+  }
   inline int AvailableFor( int vc = 0 ) const {
     return _buffer_policy->AvailableFor(vc);
   }
@@ -31,30 +31,31 @@
 //
 //  The Channel models a generic channel with a multi-cycle 
 //   transmission delay. The channel latency can be specified as 
-//   an integer number of simulator cycles.
+//   an integer number of simulator cycles. The state of the channel
+//   is kept in the ChannelBank of its network.
 //
 /////
 #ifndef _CHANNEL_HPP
 #define _CHANNEL_HPP
 
-#include <queue>
 #include <cassert>
 
 #include "globals.hpp"
 #include "module.hpp"
 #include "timed_module.hpp"
+#include "channel_bank.hpp"
 
 using namespace std;
 
 template<typename T>
 class Channel : public TimedModule {
 public:
-  Channel(Module * parent, string const & name);
+  Channel(Module * parent, string const & name, ChannelBank * bank);
   virtual ~Channel() {}
 
   // Physical Parameters
   void SetLatency(int cycles);
-  int GetLatency() const { return _delay ; }
+  int GetLatency() const { return _bank->GetLatency(_index) ; }
   
   // Send data 
   virtual void Send(T * data);
@@ -66,17 +67,27 @@ public:
   virtual void Evaluate() {}
   virtual void WriteOutputs();
 
+  virtual bool IsIdle() const {
+    return _bank->IsIdle(_index);
+  }
+
+  // module reading the channel output; it is woken while output is pending
+  void SetReceiver(TimedModule const * receiver) { _bank->SetReceiver(_index, receiver); }
+
 protected:
-  int _delay;
-  T * _input;
-  T * _output;
-  queue<pair<int, T *> > _wait_queue;
+  ChannelBank * const _bank;
+  int const _index;
+
+  inline T * _Input() const { return static_cast<T *>(_bank->Input(_index)); }
+  inline void _SetInput(T * data) { _bank->Input(_index) = data; }
+  inline T * _Output() const { return static_cast<T *>(_bank->Output(_index)); }
+  inline void _SetOutput(T * data) { _bank->Output(_index) = data; }
 
 };
 
 template<typename T>
-Channel<T>::Channel(Module * parent, string const & name)
-  : TimedModule(parent, name), _delay(1), _input(0), _output(0) {
+Channel<T>::Channel(Module * parent, string const & name, ChannelBank * bank)
+  : TimedModule(parent, name), _bank(bank), _index(bank->Add(this)) {
 }
 
 template<typename T>
@@ -84,42 +95,28 @@ void Channel<T>::SetLatency(int cycles) {
   if(cycles <= 0) {
     Error("Channel must have positive delay.");
   }
-  _delay = cycles ;
+  _bank->SetLatency(_index, cycles);
 }
 
 template<typename T>
 void Channel<T>::Send(T * data) {
-  _input = data;
+  _SetInput(data);
+  if(data) Wake();
 }
 
 template<typename T>
 T * Channel<T>::Receive() {
-  return _output;
+  return _Output();
 }
 
 template<typename T>
 void Channel<T>::ReadInputs() {
-  if(_input) {
-    _wait_queue.push(make_pair(GetSimTime() + _delay - 1, _input));
-    _input = 0;
-  }
+  _bank->ReadInput(_index, GetSimTime());
 }
 
 template<typename T>
 void Channel<T>::WriteOutputs() {
-  _output = 0;
-  if(_wait_queue.empty()) {
-    return;
-  }
-  pair<int, T *> const & item = _wait_queue.front();
-  int const & time = item.first;
-  if(GetSimTime() < time) {
-    return;
-  }
-  assert(GetSimTime() == time);
-  _output = item.second;
-  assert(_output);
-  _wait_queue.pop();
+  _bank->WriteOutput(_index, GetSimTime());
 }
 
 #endif
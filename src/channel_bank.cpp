@@ -0,0 +1,108 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "booksim.hpp"
+#include "globals.hpp"
+#include "channel_bank.hpp"
+
+ChannelBank::~ChannelBank( )
+{
+  for ( size_t c = 0; c < _slots.size( ); ++c ) {
+    delete [] _slots[c];
+  }
+}
+
+int ChannelBank::Add( TimedModule * channel )
+{
+  _input.push_back( 0 );
+  _output.push_back( 0 );
+  _delay.push_back( 1 );
+  _slots.push_back( 0 );
+  _mask.push_back( 0 );
+  _in_flight.push_back( 0 );
+  _receiver.push_back( 0 );
+  _module.push_back( channel );
+  _hook.push_back( 0 );
+  return (int)_module.size( ) - 1;
+}
+
+void ChannelBank::SetLatency( int c, int cycles )
+{
+  assert( cycles > 0 );
+  assert( !_in_flight[c] );
+  _delay[c] = cycles;
+  delete [] _slots[c];
+  _slots[c] = 0;
+}
+
+void ChannelBank::_Allocate( int c )
+{
+  int size = 1;
+  while ( size < _delay[c] ) {
+    size *= 2;
+  }
+  _slots[c] = new void * [size];
+  for ( int s = 0; s < size; ++s ) {
+    _slots[c][s] = 0;
+  }
+  _mask[c] = size - 1;
+}
+
+void ChannelBank::ReadInputs( int begin, int end, atomic<unsigned char> * awake )
+{
+  int const time = GetSimTime( );
+  for ( int c = begin; c < end; ++c ) {
+    if ( !awake[c].load( memory_order_relaxed ) ) {
+      continue;
+    }
+    if ( _hook[c] ) {
+      _module[c]->ReadInputs( );
+    } else {
+      ReadInput( c, time );
+    }
+  }
+}
+
+void ChannelBank::WriteOutputs( int begin, int end, atomic<unsigned char> * awake )
+{
+  int const time = GetSimTime( );
+  for ( int c = begin; c < end; ++c ) {
+    if ( !awake[c].load( memory_order_relaxed ) ) {
+      continue;
+    }
+    bool idle;
+    if ( _hook[c] ) {
+      _module[c]->WriteOutputs( );
+      idle = _module[c]->IsIdle( );
+    } else {
+      WriteOutput( c, time );
+      idle = IsIdle( c );
+    }
+    if ( idle ) {
+      awake[c].store( 0, memory_order_relaxed );
+    }
+  }
+}
@@ -0,0 +1,122 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//////////////////////////////////////////////////////////////////////
+//
+//  File Name: channel_bank.hpp
+//
+//  The ChannelBank holds the state of all channels of a network in
+//   one array per field. A channel is a ring of slots indexed by the
+//   cycle its data leaves, so a fixed latency needs no queue nodes,
+//   and the network runs the channel phases in one loop over the bank.
+//
+/////
+#ifndef _CHANNEL_BANK_HPP_
+#define _CHANNEL_BANK_HPP_
+
+#include <vector>
+#include <atomic>
+#include <cassert>
+
+#include "timed_module.hpp"
+
+using namespace std;
+
+class ChannelBank {
+
+  vector<void *> _input;
+  vector<void *> _output;
+  vector<int> _delay;
+  // the ring of a channel has a power-of-two number of slots, at least
+  // _delay, and is allocated when the first data is sent
+  vector<void **> _slots;
+  vector<int> _mask;
+  vector<int> _in_flight;
+  vector<TimedModule const *> _receiver;
+  vector<TimedModule *> _module;
+  // set while a channel has to run its own ReadInputs and WriteOutputs
+  vector<unsigned char> _hook;
+
+  void _Allocate( int c );
+
+public:
+  ChannelBank( ) { }
+  ~ChannelBank( );
+
+  int Add( TimedModule * channel );
+
+  void SetLatency( int c, int cycles );
+  inline int GetLatency( int c ) const { return _delay[c]; }
+
+  inline void SetReceiver( int c, TimedModule const * receiver ) { _receiver[c] = receiver; }
+  inline void SetHook( int c, bool hook ) { _hook[c] = hook; }
+
+  inline void * & Input( int c ) { return _input[c]; }
+  inline void * Input( int c ) const { return _input[c]; }
+  inline void * & Output( int c ) { return _output[c]; }
+  inline void * Output( int c ) const { return _output[c]; }
+
+  inline bool IsIdle( int c ) const {
+    return !_input[c] && !_output[c] && !_in_flight[c];
+  }
+
+  inline void ReadInput( int c, int time ) {
+    if ( _output[c] && _receiver[c] ) {
+      _receiver[c]->Wake( );
+    }
+    void * const data = _input[c];
+    if ( data ) {
+      if ( !_slots[c] ) {
+	_Allocate( c );
+      }
+      void * & slot = _slots[c][( time + _delay[c] - 1 ) & _mask[c]];
+      assert( !slot );
+      slot = data;
+      ++_in_flight[c];
+      _input[c] = 0;
+    }
+  }
+
+  inline void WriteOutput( int c, int time ) {
+    _output[c] = 0;
+    if ( _in_flight[c] ) {
+      void * & slot = _slots[c][time & _mask[c]];
+      if ( slot ) {
+	_output[c] = slot;
+	slot = 0;
+	--_in_flight[c];
+      }
+    }
+  }
+
+  // the channel phases of the channels begin to end; awake holds their
+  // activity flags
+  void ReadInputs( int begin, int end, atomic<unsigned char> * awake );
+  void WriteOutputs( int begin, int end, atomic<unsigned char> * awake );
+};
+
+#endif
@@ -25,64 +25,49 @@
  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-/*module.cpp
- *
- *The basic class that is extended by all other components of the network
- *Provides the basic hierarchy structure and basic fuctions
- *
- */
-
 #include <iostream>
 #include <cstdlib>
 
 #include "booksim.hpp"
-#include "module.hpp"
+#include "collective.hpp"
+#include "traffic.hpp"
 
-Module::Module( Module *parent, const string& name )
-{
-  _name = name;
+CollectiveAlgorithm gCollective = COLLECTIVE_NONE;
+bool gSingleSwitch = false;
+int max_step = 20;
 
-  if ( parent ) { 
-    parent->_AddChild( this );
-    _fullname = parent->_fullname + "/" + name;
+void InitializeCollective( Configuration const & config )
+{
+  string collective = config.GetStr( "collective" );
+  if ( collective.empty( ) ) {
+    // follow the traffic pattern of the first class; everything that is
+    // not a collective pattern is random traffic
+    collective = TrafficPattern::Collective( config.GetStrArray( "traffic" ).front( ) );
+  }
+  if ( collective == "pairwise" ) {
+    gCollective = COLLECTIVE_PAIRWISE;
+  } else if ( collective == "ring" ) {
+    gCollective = COLLECTIVE_RING;
+  } else if ( collective == "none" ) {
+    gCollective = COLLECTIVE_NONE;
   } else {
-    _fullname = name;
+    cout << "Error: Unknown collective algorithm: " << collective << endl;
+    exit(-1);
   }
-}
-
-void Module::_AddChild( Module *child )
-{
-  _children.push_back( child );
-}
-
-void Module::DisplayHierarchy( int level, ostream & os ) const
-{
-  vector<Module *>::const_iterator mod_iter;
 
-  for ( int l = 0; l < level; l++ ) {
-    os << "  ";  
+  gSingleSwitch = ( config.GetInt( "single_switch" ) > 0 );
+  if ( ( gCollective != COLLECTIVE_NONE ) && !gSingleSwitch &&
+       ( config.GetStr( "topology" ) == "fattree" ) ) {
+    // the fat-tree collectives map every node onto the single switch
+    cout << "Error: The " << collective
+	 << " collective on a fattree needs single_switch = 1." << endl;
+    exit(-1);
   }
 
-  os << _name << endl;
-
-  for ( mod_iter = _children.begin( );
-	mod_iter != _children.end( ); mod_iter++ ) {
-    (*mod_iter)->DisplayHierarchy( level + 1 );
+  max_step = config.GetInt( "max_step" );
+  if ( max_step <= 0 ) {
+    // a ring step moves one chunk, so it takes many more steps than the
+    // log2 steps of the pairwise exchange
+    max_step = ( gCollective == COLLECTIVE_RING ) ? 8192 : 20;
   }
 }
-
-void Module::Error( const string& msg ) const
-{
-  cout << "Error in " << _fullname << " : " << msg << endl;
-  exit( -1 );
-}
-
-void Module::Debug( const string& msg ) const
-{
-  cout << "Debug (" << _fullname << ") : " << msg << endl;
-}
-
-void Module::Display( ostream & os ) const 
-{
-  os << "Display method not implemented for " << _fullname << endl;
-}
@@ -0,0 +1,38 @@
+#ifndef _COLLECTIVE_HPP_
+#define _COLLECTIVE_HPP_
+
+//#define PFP_CYCLE_DEBUG // tarfficmanager
+//#define HCUBE_CYCLE_DEBUG 
+//#define FATTREE_CYCLE_DEBUG
+
+//#define PFP_STEPUP_DEBUG
+//#define HCUBE_STEPUP_DEBUG
+//#define FATTREE_STEPUP_DEBUG
+//#define HCUBE_ROUTING_DEBUG //routefunc
+//#define TORUS_ROUTING_DEBUG //routefunc
+//#define FATTREE_ROUTING_DEBUG //routefunc
+//#define FATTREE_DEBUG
+
+//#define PAIRWISE_TRAFFIC_DEBUG // traffic
+//#define RING_TRAFFIC_DEBUG // traffic
+
+#include "config_utils.hpp"
+
+// collective algorithm that gates packet injection, set by the "collective"
+// option; COLLECTIVE_NONE injects as the injection process dictates
+enum CollectiveAlgorithm {
+  COLLECTIVE_NONE,
+  COLLECTIVE_PAIRWISE,
+  COLLECTIVE_RING
+};
+
+extern CollectiveAlgorithm gCollective;
+// all nodes hang off router 0 (single-tier fat-tree), "single_switch" option
+extern bool gSingleSwitch;
+// number of steps the step-up time tables are sized for
+extern int max_step;
+
+void InitializeCollective( Configuration const & config );
+
+#endif
+
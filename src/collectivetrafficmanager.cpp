@@ -0,0 +1,412 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <limits>
+
+#include "booksim.hpp"
+#include "collectivetrafficmanager.hpp"
+#include "collective.hpp"
+#include "polarfly_tables.hpp"
+
+vector<vector<int> > stepup_time_table;
+vector<vector<int> > rxstepup_time_table;
+vector<vector<int> > txstepup_time_table;
+
+CollectiveTrafficManager::CollectiveTrafficManager( const Configuration &config, 
+						    const vector<Network *> & net )
+  : TrafficManager(config, net), _inject_idle(false)
+{
+  _nics = config.GetInt( "nic" );
+  _step_threshold = config.GetInt( "collective_threshold" );
+  _chunk = config.GetInt( "chunk" );
+  _reset_qtime = true;
+
+  // a collective schedule drives every class through the same steps
+  _schedule = dynamic_cast<SteppedTrafficPattern *>(_traffic_pattern[0]);
+  for(int c = 1; c < _classes; ++c) {
+    if((_traffic[c] != _traffic[0]) &&
+       (_schedule || dynamic_cast<SteppedTrafficPattern *>(_traffic_pattern[c]))) {
+      Error("All classes have to use the same collective schedule.");
+    }
+  }
+  Router::SetCollectiveSchedule(_schedule);
+  // the step-up tables hold every step of a schedule, which can take more
+  // steps than the default of the pairwise exchange
+  if ( _schedule ) {
+    max_step = max( config.GetInt( "max_step" ), _schedule->Steps( ) );
+  }
+
+  // a collective runs until every step is done, and a stuck one is
+  // abandoned while draining
+  _converged_periods = max_step * config.GetInt( "seq" );
+  _drain_check_period = 10000;
+  _drain_limit = 100000;
+
+  stepup_time_table.assign(_nodes, vector<int>(max_step, 0));
+  rxstepup_time_table.assign(_nodes, vector<int>(max_step, 0));
+  txstepup_time_table.assign(_nodes, vector<int>(max_step, 0));
+  _stepup_cursor.assign(_nodes, 0);
+  _rxstepup_cursor.assign(_nodes, 0);
+  _txstepup_cursor.assign(_nodes, 0);
+  _max_step_threshold = 0;
+  for (int i = 0; i < max_step; i++){
+    if(  ( 1 << i ) >= _nodes/_nics ) {
+      _max_step_threshold = i;
+      break;
+    }
+  }
+}
+
+CollectiveTrafficManager::~CollectiveTrafficManager( )
+{
+  Router::SetCollectiveSchedule(NULL);
+}
+
+void CollectiveTrafficManager::_GeneratePacket( int source, int stype, 
+						int cl, int time )
+{
+  int const pid = _cur_pid;
+  TrafficManager::_GeneratePacket( source, stype, cl, time );
+  // packets to or from a faulty node are dropped without an id
+  if ( _schedule && ( _cur_pid != pid ) ) {
+    ++_schedule_sent[source];
+  }
+}
+
+// Records the current time as step-up time of the steps in [cursor, step).
+// Entries are only ever filled in from the cursor on, so the cursor is the
+// first unset entry of the row. Returns true if any entry was written.
+bool CollectiveTrafficManager::_RecordStepUp( vector<int> & times, int & cursor, int step )
+{
+  int const end = min(step, max_step);
+  if ( end <= cursor ) {
+    return false;
+  }
+  for ( int i = cursor; i < end; ++i ) {
+    times[i] = _time;
+  }
+  // a time of 0 still reads as unset
+  if ( _time != 0 ) {
+    cursor = end;
+  }
+  return true;
+}
+
+// Advances the collective state of an input for the pairwise or ring
+// pattern. Returns false if the input generates nothing this cycle.
+bool CollectiveTrafficManager::_StepReady( int input )
+{
+	int nodeid = input / _nics;
+	int nicid = input % _nics;
+	// the single switch counts the steps of every node at router 0
+	Router * const router = _net[0]->GetRouter(gSingleSwitch ? 0 : nodeid);
+	int step= router->step_cal(gSingleSwitch ? input : nicid) ;
+	int rxstep= router->Get_rx_step(gSingleSwitch ? input : nicid);
+	int txstep= router->Get_tx_step(gSingleSwitch ? input : nicid);
+	if(_RecordStepUp(stepup_time_table[nodeid], _stepup_cursor[nodeid], step)) _inject_idle = false;
+	if(_RecordStepUp(rxstepup_time_table[nodeid], _rxstepup_cursor[nodeid], rxstep)) _inject_idle = false;
+	if(_RecordStepUp(txstepup_time_table[nodeid], _txstepup_cursor[nodeid], txstep)) _inject_idle = false;
+	if(gCollective == COLLECTIVE_PAIRWISE) {
+		//for pairwise pattern
+		int const max_step_threshold = _max_step_threshold;
+		if(gSingleSwitch) {
+			while(  ( (nodeid^(1<<step)) >= _nodes ) && ( (1 << step) < _nodes ) ){ //no pair 
+				_inject_idle = false;
+				router->rx_count(step,_step_threshold,nodeid);
+				router->tx_count(step,_step_threshold,nodeid);
+				step= router->step_cal(nodeid) ;
+				if(step_table[0][nodeid] < step)step_table[0][nodeid] = step;
+			}
+			if ( (1 << step) >= _nodes){
+				if(cycle_table[nodeid] == 0) {
+					_inject_idle = false;
+					cycle_table[nodeid] = _time - delay_table[nodeid];
+					delay_table[nodeid] = _time;
+				}
+				return false;
+			}
+		} else {
+			while(  ( (nodeid^(1<<((step+nicid)%max_step_threshold))) >= (_nodes/_nics) )
+				&& ( (step-nicid) <= max_step_threshold ) ){ //no pair
+				_inject_idle = false;
+				router->rx_count(step,_step_threshold,nicid);
+				router->tx_count(step,_step_threshold,nicid);
+				step= router->step_cal(nicid) ;
+				if(step_table[nodeid][nicid] < step)step_table[nodeid][nicid] = step;
+			}
+			if( (step-nicid) >= max_step_threshold ){
+				if(cycle_table[nodeid] == 0) { 
+					_inject_idle = false;
+					cycle_table[nodeid] = _time - delay_table[nodeid]; 
+					delay_table[nodeid] = _time;
+				}
+				return false;
+			}
+		}
+	} else {
+		//for ring pattern
+		if ( step >= (2 * (_nodes - 1) * (_chunk/_nodes) - 1)){
+			if(cycle_table[nodeid] == 0) {
+				_inject_idle = false;
+				cycle_table[nodeid] = _time - delay_table[nodeid];
+				delay_table[nodeid] = _time;
+			}
+			return false;
+		}
+	}
+	if(step < txstep) {
+		for (int c = 0 ; c < _classes; ++c ) {
+			if(!_qdrained[input][c]) _inject_idle = false;
+			_qdrained[input][c]=true;
+		}
+		return false;
+	}
+	return true;
+}
+
+// Advances an input through the steps of the collective schedule. Returns
+// false while the input has sent everything its current step asks for.
+bool CollectiveTrafficManager::_ScheduleReady( int input )
+{
+	int const nodeid = input / _nics;
+	int const row = gSingleSwitch ? 0 : nodeid;
+	int const nic = gSingleSwitch ? input : (input % _nics);
+	Router * const router = _net[0]->GetRouter(row);
+	if(router->step_skip(_step_threshold, nic)) _inject_idle = false;
+	int const step = router->step_cal(nic);
+	if(_RecordStepUp(stepup_time_table[nodeid], _stepup_cursor[nodeid], step)) _inject_idle = false;
+	if(_RecordStepUp(rxstepup_time_table[nodeid], _rxstepup_cursor[nodeid], router->Get_rx_step(nic))) _inject_idle = false;
+	if(_RecordStepUp(txstepup_time_table[nodeid], _txstepup_cursor[nodeid], router->Get_tx_step(nic))) _inject_idle = false;
+	step_table[row][nic] = step;
+	int const steps = _schedule->Steps();
+	// steps the input completed since it was last looked at
+	while(_schedule_step[input] < min(step, steps)) {
+		_step_done[_schedule_step[input]] = max(_step_done[_schedule_step[input]], _time);
+		++_schedule_step[input];
+		_schedule_sent[input] = 0;
+		_inject_idle = false;
+	}
+	if(step >= steps) {
+		if(cycle_table[nodeid] == 0) {
+			_inject_idle = false;
+			cycle_table[nodeid] = _time - delay_table[nodeid];
+			delay_table[nodeid] = _time;
+		}
+		for (int c = 0 ; c < _classes; ++c ) {
+			if(!_qdrained[input][c]) _inject_idle = false;
+			_qdrained[input][c]=true;
+		}
+		return false;
+	}
+	// the packets of a step are counted at the source router, so the input
+	// stops after issuing them instead of until the count catches up
+	return ( step >= router->Get_tx_step(nic) ) &&
+		( _schedule_sent[input] < _schedule->TxBlocks(input, step) * _step_threshold );
+}
+
+void CollectiveTrafficManager::_Inject(){	
+  // nothing can retire later in this step if nothing was in flight
+  _inject_idle = true;
+  for ( int c = 0; c < _classes; ++c ) {
+    if ( !_total_in_flight_flits[c].empty() ) {
+      _inject_idle = false;
+    }
+  }
+  // inputs whose start delay is over take part again
+  if ( !_delayed_inputs.empty() && ( _delayed_inputs.top().first <= _time ) ) {
+    while ( !_delayed_inputs.empty() && ( _delayed_inputs.top().first <= _time ) ) {
+      _active_inputs.push_back(_delayed_inputs.top().second);
+      _delayed_inputs.pop();
+    }
+    sort(_active_inputs.begin(), _active_inputs.end());
+    _inject_idle = false;
+  }
+  // inputs stay in the worklist unless they are parked for their delay
+  size_t active = 0;
+  for ( size_t a = 0; a < _active_inputs.size(); ++a ) {
+    int const input = _active_inputs[a];
+    _active_inputs[active++] = input;
+    int nodeid = input / _nics;
+    if(delay_table[nodeid]  > _time) {
+      --active;
+      _delayed_inputs.push(make_pair(delay_table[nodeid], input));
+      continue;
+    }
+    if ( _schedule ? !_ScheduleReady( input ) : !_StepReady( input ) ) {
+      continue;
+    }
+    // packet generation may draw random numbers every cycle
+    _inject_idle = false;
+    _InjectInput( input );
+  }
+  _active_inputs.resize(active);
+}
+
+// Skips up to max_cycles cycles after a step in which nothing happened: the
+// network has gone to sleep, no packet is waiting for injection and _Inject
+// changed no state, so every cycle until the next parked input wakes up
+// would repeat that step exactly. Returns the number of cycles skipped.
+int CollectiveTrafficManager::_FastForward( int max_cycles )
+{
+    if ( !_inject_idle || gTrace || ( max_cycles <= 0 ) ) {
+        return 0;
+    }
+#ifdef PFP_DEBUG
+    return 0;
+#endif
+    for ( int subnet = 0; subnet < _subnets; ++subnet ) {
+        if ( !_net[subnet]->IsIdle( ) ) {
+            return 0;
+        }
+    }
+    for ( int c = 0; c < _classes; ++c ) {
+        if ( !_total_in_flight_flits[c].empty( ) ) {
+            return 0;
+        }
+        for ( int n = 0; n < _nodes; ++n ) {
+            if ( !_partial_packets[n][c].empty( ) ) {
+                return 0;
+            }
+        }
+    }
+    int skip = max_cycles;
+    if ( !_delayed_inputs.empty( ) ) {
+        skip = min(skip, _delayed_inputs.top( ).first - _time);
+    }
+    if ( skip <= 0 ) {
+        return 0;
+    }
+    _time += skip;
+    return skip;
+}
+
+bool CollectiveTrafficManager::_SingleSim( )
+{
+    // the single switch counts the steps of every node at router 0
+    int const nics = gSingleSwitch ? _nodes : _nics;
+    for (int input = 0; input < _net[0]->NumRouters(); input++){
+        for (int n = 0; n < nics; n++){
+            (_net[0]->GetRouter(input))->step_reset(n);
+            step_table[input][n] = 0;
+        }
+        for(int i = 0 ; i < max_step; i++){
+            stepup_time_table[input][i]=0;
+            rxstepup_time_table[input][i]=0;
+            txstepup_time_table[input][i]=0;
+        }
+        _stepup_cursor[input] = 0;
+        _rxstepup_cursor[input] = 0;
+        _txstepup_cursor[input] = 0;
+    }
+    if ( _schedule ) {
+        _schedule_step.assign(_nodes, 0);
+        _schedule_sent.assign(_nodes, 0);
+        _step_done.assign(_schedule->Steps(), 0);
+    }
+    _active_inputs.clear();
+    while (!_delayed_inputs.empty()) {
+        _delayed_inputs.pop();
+    }
+    for (int input = 0; input < _nodes; input++){
+        _active_inputs.push_back(input);
+    }
+    return TrafficManager::_SingleSim( );
+}
+
+void CollectiveTrafficManager::DisplayOverallStats( ostream & os ) const {
+
+    TrafficManager::DisplayOverallStats(os);
+
+#ifdef PFP_STEPUP_DEBUG
+   for(int i = 0 ; i < _routers; i++ ){       
+     cout << "##step node" << i << " : ";
+     for(int j = 0 ; j < max_step; j++){
+        cout << stepup_time_table[i][j] << " " ; 
+     }
+     cout << endl;
+   }
+   for(int i = 0 ; i < _routers; i++ ){
+     cout << "##rxstep node" << i << " : ";
+     for(int j = 0 ; j < max_step; j++){
+        cout << rxstepup_time_table[i][j] << " " ;
+     }
+     cout << endl;
+   }
+   for(int i = 0 ; i < _routers; i++ ){
+     cout << "##txstep node" << i << " : ";
+     for(int j = 0 ; j < max_step; j++){
+        cout << txstepup_time_table[i][j] << " " ;
+     }
+     cout << endl;
+   }
+#endif
+#ifdef HCUBE_STEPUP_DEBUG
+   for(int i = 0 ; i < _routers; i++ ){
+     cout << "##node" << i << " : ";
+     for(int j = 0 ; j < max_step; j++){
+        cout << stepup_time_table[i][j] << " " ;
+     }
+     cout << endl;
+   }
+#endif
+#ifdef FATTREE_STEPUP_DEBUG
+   for(int i = 0 ; i < _nodes; i++ ){
+     cout << "##node" << i << " : ";
+     for(int j = 0 ; j < max_step; j++){
+        cout << stepup_time_table[i][j] << " " ;
+     }
+     cout << endl;
+   }
+#endif
+#ifdef PFP_CYCLE_DEBUG
+    for(int i = 0 ; i < _routers; i++ ){
+        cout << "##node" << i << " : " << cycle_table[i] <<  endl;
+        //cout << cycle_table[i] << endl;
+    }
+#endif
+#ifdef HCUBE_CYCLE_DEBUG
+    for(int i = 0 ; i < _routers; i++ ){
+        cout << "##node" << i << " : " << cycle_table[i] <<  endl;
+        //cout << cycle_table[i] << endl;
+    }
+#endif
+#ifdef FATTREE_CYCLE_DEBUG
+    for(int i = 0 ; i < _nodes; i++ ){
+        cout << "##node" << i << " : " << cycle_table[i] <<  endl;
+        //cout << cycle_table[i] << endl;
+    }
+#endif
+
+    if ( _schedule ) {
+        os << "Collective step completion times:" << endl;
+        for ( int step = 0; step < _schedule->Steps( ); ++step ) {
+            os << "##step" << step << " : " << _step_done[step] << endl;
+        }
+    }
+  
+}
@@ -0,0 +1,89 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _COLLECTIVETRAFFICMANAGER_HPP_
+#define _COLLECTIVETRAFFICMANAGER_HPP_
+
+#include <iostream>
+#include <queue>
+
+#include "config_utils.hpp"
+#include "trafficmanager.hpp"
+
+// Injects the packets of a collective: an input only generates packets for
+// the step its NIC is in, and moves on once the routers counted the packets
+// of that step as sent and received.
+class CollectiveTrafficManager : public TrafficManager {
+
+protected:
+
+  int _nics;
+  int _step_threshold;
+  int _chunk;
+
+  // first step of each node whose step-up time is not recorded yet
+  vector<int> _stepup_cursor;
+  vector<int> _rxstepup_cursor;
+  vector<int> _txstepup_cursor;
+  // inputs _Inject has to look at, in increasing order; inputs waiting for
+  // their start delay are parked in _delayed_inputs until it is over
+  vector<int> _active_inputs;
+  priority_queue<pair<int, int>, vector<pair<int, int> >,
+		 greater<pair<int, int> > > _delayed_inputs;
+  int _max_step_threshold;
+  // set by _Inject when it left all state as it was and nothing was in
+  // flight, so the following cycles may be skipped by _FastForward
+  bool _inject_idle;
+
+  // collective schedule of the traffic pattern, NULL for the pairwise or
+  // ring pattern
+  SteppedTrafficPattern * _schedule;
+  // per input: steps completed and packets issued in the current step
+  vector<int> _schedule_step;
+  vector<int> _schedule_sent;
+  // time the last input completed each step of the schedule
+  vector<int> _step_done;
+
+  bool _RecordStepUp( vector<int> & times, int & cursor, int step );
+  bool _StepReady( int input );
+  bool _ScheduleReady( int input );
+
+  virtual void _Inject( );
+  virtual int _FastForward( int max_cycles );
+  virtual void _GeneratePacket( int source, int size, int cl, int time );
+  virtual bool _SingleSim( );
+
+public:
+
+  CollectiveTrafficManager( const Configuration &config, const vector<Network *> & net );
+  virtual ~CollectiveTrafficManager( );
+
+  virtual void DisplayOverallStats( ostream & os = cout ) const;
+
+};
+
+#endif
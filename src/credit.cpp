@@ -30,11 +30,24 @@
  *A class for credits
  */
 
+#include <mutex>
+
 #include "booksim.hpp"
 #include "credit.hpp"
 
-stack<Credit *> Credit::_all;
-stack<Credit *> Credit::_free;
+vector<Credit::Pool *> Credit::_pools;
+thread_local Credit::Pool * Credit::_local = NULL;
+
+static mutex gCreditPoolMutex;
+
+Credit::Pool & Credit::_Pool() {
+  if(!_local) {
+    _local = new Pool;
+    lock_guard<mutex> lock(gCreditPoolMutex);
+    _pools.push_back(_local);
+  }
+  return *_local;
+}
 
 Credit::Credit()
 {
@@ -44,36 +57,50 @@ Credit::Credit()
 void Credit::Reset()
 {
   vc.clear();
+  train = 1;
   head = false;
   tail = false;
   id   = -1;
 }
 
 Credit * Credit::New() {
+  Pool & p = _Pool();
   Credit * c;
-  if(_free.empty()) {
+  if(p.free.empty()) {
     c = new Credit();
-    _all.push(c);
+    p.all.push(c);
   } else {
-    c = _free.top();
+    c = p.free.top();
     c->Reset();
-    _free.pop();
+    p.free.pop();
   }
   return c;
 }
 
 void Credit::Free() {
-  _free.push(this);
+  _Pool().free.push(this);
 }
 
 void Credit::FreeAll() {
-  while(!_all.empty()) {
-    delete _all.top();
-    _all.pop();
+  lock_guard<mutex> lock(gCreditPoolMutex);
+  for(size_t i = 0; i < _pools.size(); ++i) {
+    Pool & p = *_pools[i];
+    while(!p.all.empty()) {
+      delete p.all.top();
+      p.all.pop();
+    }
+    while(!p.free.empty()) {
+      p.free.pop();
+    }
   }
 }
 
 
 int Credit::OutStanding(){
-  return _all.size()-_free.size();
+  lock_guard<mutex> lock(gCreditPoolMutex);
+  int outstanding = 0;
+  for(size_t i = 0; i < _pools.size(); ++i) {
+    outstanding += _pools[i]->all.size() - _pools[i]->free.size();
+  }
+  return outstanding;
 }
@@ -28,14 +28,80 @@
 #ifndef _CREDIT_HPP_
 #define _CREDIT_HPP_
 
-#include <set>
 #include <stack>
+#include <vector>
+
+// set of VCs returned by a credit, kept as a fixed-width bitmask so that
+// credits neither allocate nor walk a tree; VCs are visited in increasing
+// order with First() and Next()
+class VCMask {
+
+public:
+
+  enum { max_vcs = 256 };
+
+  VCMask() { clear(); }
+
+  void clear() {
+    for(int w = 0; w < _words; ++w) {
+      _bits[w] = 0;
+    }
+  }
+  void insert(int vc) {
+    _bits[vc >> 6] |= (1ULL << (vc & 63));
+  }
+  bool count(int vc) const {
+    return (_bits[vc >> 6] >> (vc & 63)) & 1;
+  }
+  bool empty() const {
+    for(int w = 0; w < _words; ++w) {
+      if(_bits[w]) {
+	return false;
+      }
+    }
+    return true;
+  }
+  int size() const {
+    int n = 0;
+    for(int w = 0; w < _words; ++w) {
+      n += __builtin_popcountll(_bits[w]);
+    }
+    return n;
+  }
+
+  // lowest VC in the set, -1 if empty
+  int First() const { return _Scan(0); }
+  // lowest VC in the set above vc, -1 if none
+  int Next(int vc) const { return (vc + 1 < max_vcs) ? _Scan(vc + 1) : -1; }
+
+private:
+
+  enum { _words = max_vcs / 64 };
+
+  unsigned long long _bits[_words];
+
+  int _Scan(int from) const {
+    int w = from >> 6;
+    unsigned long long b = _bits[w] & (~0ULL << (from & 63));
+    while(!b) {
+      if(++w == _words) {
+	return -1;
+      }
+      b = _bits[w];
+    }
+    return (w << 6) + __builtin_ctzll(b);
+  }
+
+};
 
 class Credit {
 
 public:
 
-  set<int> vc;
+  VCMask vc;
+
+  // credits returned for each VC in vc (the length of a flit train)
+  int train;
 
   // these are only used by the event router
   bool head, tail;
@@ -49,8 +115,15 @@ public:
   static int OutStanding();
 private:
 
-  static stack<Credit *> _all;
-  static stack<Credit *> _free;
+  // credits are recycled per thread; a credit may be freed by another
+  // thread than the one that allocated it
+  struct Pool {
+    stack<Credit *> all;
+    stack<Credit *> free;
+  };
+  static vector<Pool *> _pools;
+  static thread_local Pool * _local;
+  static Pool & _Pool();
 
   Credit();
   ~Credit() {}
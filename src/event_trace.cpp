@@ -0,0 +1,112 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+
+#include "globals.hpp"
+#include "event_trace.hpp"
+
+EventTrace * gEventTrace = NULL;
+
+thread_local EventTrace::Buffer * EventTrace::_local = NULL;
+thread_local int EventTrace::_local_generation = 0;
+int EventTrace::_generations = 0;
+
+EventTrace::EventTrace( const string & filename )
+  : _generation( ++_generations )
+{
+  _file = fopen( filename.c_str( ), "wb" );
+  if ( !_file ) {
+    cout << "Error: cannot open event trace file " << filename << endl;
+    exit(-1);
+  }
+  char const magic[8] = { 'B', 'S', 'E', 'V', 'T', 'R', 'C', '1' };
+  unsigned int const header[2] = { (unsigned int)sizeof(Event), 0 };
+  fwrite( magic, 1, sizeof(magic), _file );
+  fwrite( header, sizeof(header[0]), 2, _file );
+}
+
+EventTrace::~EventTrace( )
+{
+  for ( size_t i = 0; i < _buffers.size( ); ++i ) {
+    _Write( _buffers[i] );
+    delete _buffers[i];
+  }
+  fclose( _file );
+}
+
+EventTrace::Buffer * EventTrace::_Local( )
+{
+  if ( _local_generation != _generation ) {
+    _local = new Buffer;
+    _local->events.resize( _buffer_events );
+    _local->count = 0;
+    _local_generation = _generation;
+    lock_guard<mutex> lock( _lock );
+    _buffers.push_back( _local );
+  }
+  return _local;
+}
+
+void EventTrace::_Write( Buffer * b )
+{
+  lock_guard<mutex> lock( _lock );
+  fwrite( &b->events[0], sizeof(Event), b->count, _file );
+  b->count = 0;
+}
+
+void EventTrace::Record( eEventType type, int where, int port, int vc,
+			 int id, int pid, int aux )
+{
+  _Append( GetSimTime( ), type, where, port, vc, id, pid, aux );
+}
+
+void EventTrace::RecordCreate( Flit const * f )
+{
+  _Append( f->ctime, create, f->src, -1, -1, f->id, f->pid, f->dest );
+}
+
+void EventTrace::_Append( int time, eEventType type, int where, int port,
+			  int vc, int id, int pid, int aux )
+{
+  Buffer * const b = _Local( );
+  Event & e = b->events[b->count];
+  e.time = time;
+  e.id = id;
+  e.pid = pid;
+  e.where = where;
+  e.aux = aux;
+  e.port = port;
+  e.vc = vc;
+  e.type = type;
+  memset( e.reserved, 0, sizeof(e.reserved) );
+  if ( ++b->count == _buffer_events ) {
+    _Write( b );
+  }
+}
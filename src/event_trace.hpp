@@ -0,0 +1,125 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*event_trace.hpp
+ *
+ *Opt-in binary trace of flit events (event_trace_out). Every event is a
+ *fixed-size record appended to a buffer of the calling thread; a full
+ *buffer is written to the file under a lock, so recording itself takes
+ *no lock. Records of different threads are interleaved in buffer-sized
+ *blocks, so the file is not sorted by time.
+ *
+ *File layout: the 8-byte magic "BSEVTRC1", the record size and a reserved
+ *word (both 32-bit), then the records in host byte order. See
+ *utils/eventtrace.py for a reader.
+ *
+ */
+
+#ifndef _EVENT_TRACE_HPP_
+#define _EVENT_TRACE_HPP_
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <mutex>
+
+#include "flit.hpp"
+
+using namespace std;
+
+class EventTrace {
+
+public:
+
+  // where is a node for create, inject and eject and a router otherwise;
+  // port is the input (arrive, route, credit), the output (vc_grant,
+  // sw_traverse), the subnet (inject, eject) or the NIC (step_tx,
+  // step_rx); aux is the destination (create, inject), the hop count
+  // (eject), the input (vc_grant, sw_traverse) or the new step (step_tx,
+  // step_rx)
+  enum eEventType { create, inject, arrive, route, vc_grant, sw_traverse,
+		    eject, credit, step_tx, step_rx };
+
+  struct Event {
+    int time;
+    int id;
+    int pid;
+    int where;
+    int aux;
+    short port;
+    short vc;
+    unsigned char type;
+    unsigned char reserved[3];
+  };
+
+  EventTrace( const string & filename );
+  ~EventTrace( );
+
+  void Record( eEventType type, int where, int port, int vc,
+	       int id, int pid, int aux );
+
+  inline void Record( eEventType type, int where, int port,
+		      Flit const * f, int aux = -1 ) {
+    Record( type, where, port, f->vc, f->id, f->pid, aux );
+  }
+
+  // creation of the packet of head flit f, at its creation time
+  void RecordCreate( Flit const * f );
+
+private:
+
+  enum { _buffer_events = 4096 };
+
+  struct Buffer {
+    vector<Event> events;
+    int count;
+  };
+
+  FILE * _file;
+  // distinguishes the traces of one run from each other, even if one is
+  // allocated where an earlier one was
+  int _generation;
+  static int _generations;
+  // buffers of all threads, written out by the destructor
+  vector<Buffer *> _buffers;
+  mutex _lock;
+
+  // buffer of the calling thread, for the trace it belongs to
+  static thread_local Buffer * _local;
+  static thread_local int _local_generation;
+
+  Buffer * _Local( );
+  void _Write( Buffer * b );
+  void _Append( int time, eEventType type, int where, int port, int vc,
+		int id, int pid, int aux );
+
+};
+
+// NULL unless event_trace_out is set
+extern EventTrace * gEventTrace;
+
+#endif
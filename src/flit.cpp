@@ -70,6 +70,7 @@ void Flit::Reset()
   atime     = -1 ;
   id        = -1 ;
   pid       = -1 ;
+  train     = 1 ;
   hops      = 0 ;
   watch     = false ;
   record    = false ;
@@ -79,7 +80,14 @@ void Flit::Reset()
   pri = 0;
   intm =-1;
   ph = -1;
-  data = 0;
+  for ( int i = 0; i < 3; ++i ) {
+    route.local_move[i] = 0;
+  }
+  route.global_port[0] = 0;
+  route.global_port[1] = 0;
+
+  step = 0;
+  destnic = 0;
 }  
 
 Flit * Flit::New() {
@@ -34,6 +34,13 @@
 #include "booksim.hpp"
 #include "outputset.hpp"
 
+// PolarFly+ source route: hypercube moves of the three local phases and the
+// two global ports, packed so that a route table entry is the route itself
+struct PolarFlyRoute {
+  unsigned char local_move[3];
+  unsigned char global_port[2];
+};
+
 class Flit {
 
 public:
@@ -60,6 +67,10 @@ public:
   int  id;
   int  pid;
 
+  // number of flits this flit stands for; a body train of flit_train
+  // covers the ids id to id + train - 1
+  int  train;
+
   bool record;
 
   int  src;
@@ -70,15 +81,18 @@ public:
   int  hops;
   bool watch;
   int  subnetwork;
-  
+
+  int step; //used for multistep traffic pattern in Trafficmanager.cpp
+  mutable int destnic; //for multi-NIC routing
+
   // intermediate destination (if any)
   mutable int intm;
 
   // phase in multi-phase algorithms
   mutable int ph;
 
-  // Fields for arbitrary data
-  void* data ;
+  // PolarFly+ source route, written at the injection router
+  mutable PolarFlyRoute route;
 
   // Lookahead route info
   OutputSet la_route_set;
@@ -25,33 +25,35 @@
  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-#include "packet_reply_info.hpp"
+#include "flit_table.hpp"
 
-stack<PacketReplyInfo*> PacketReplyInfo::_all;
-stack<PacketReplyInfo*> PacketReplyInfo::_free;
-
-PacketReplyInfo * PacketReplyInfo::New()
+FlitTable::FlitTable( )
+  : _slots(1024, (Flit *)NULL), _mask(1023), _base(0), _end(0), _count(0),
+    _ctime_sum(0)
 {
-  PacketReplyInfo * pr;
-  if(_free.empty()) {
-    pr = new PacketReplyInfo();
-    _all.push(pr);
-  } else {
-    pr = _free.top();
-    _free.pop();
-  }
-  return pr;
 }
 
-void PacketReplyInfo::Free()
+void FlitTable::_Grow( int span )
 {
-  _free.push(this);
+  int size = _slots.size( );
+  while ( size < span ) {
+    size *= 2;
+  }
+  vector<Flit *> slots(size, (Flit *)NULL);
+  int const mask = size - 1;
+  for ( int id = _base; id < _end; ++id ) {
+    slots[id & mask] = _slots[id & _mask];
+  }
+  _slots.swap(slots);
+  _mask = mask;
 }
 
-void PacketReplyInfo::FreeAll()
+int FlitTable::Next( int id ) const
 {
-  while(!_all.empty()) {
-    delete _all.top();
-    _all.pop();
+  for ( ++id; id < _end; ++id ) {
+    if ( _slots[id & _mask] ) {
+      return id;
+    }
   }
+  return -1;
 }
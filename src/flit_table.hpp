@@ -0,0 +1,122 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*flit_table.hpp
+ *
+ *Flits (or packets) in flight, indexed by id. Ids are handed out in
+ *increasing order and retire roughly in order, so the live ids fit in a
+ *window that is kept in a ring buffer of slots: insert, lookup and remove
+ *are O(1) and allocate nothing once the ring has grown to the window. The
+ *sum of the creation times is kept so that the age of everything in the
+ *table is available without walking it.
+ *
+ */
+
+#ifndef _FLIT_TABLE_HPP_
+#define _FLIT_TABLE_HPP_
+
+#include <vector>
+#include <cassert>
+
+#include "flit.hpp"
+
+using namespace std;
+
+class FlitTable {
+
+  vector<Flit *> _slots;
+  int _mask;
+  // window [_base, _end) holding every id in the table
+  int _base;
+  int _end;
+  int _count;
+  long long _ctime_sum;
+
+  void _Grow( int span );
+
+public:
+
+  FlitTable( );
+
+  void Insert( int id, Flit * f ) {
+    assert( id >= 0 );
+    if ( _count == 0 ) {
+      _base = id;
+      _end = id + 1;
+    } else if ( id < _base || id >= _end ) {
+      int const base = ( id < _base ) ? id : _base;
+      int const end = ( id >= _end ) ? ( id + 1 ) : _end;
+      if ( end - base > (int)_slots.size( ) ) {
+	_Grow( end - base );
+      }
+      _base = base;
+      _end = end;
+    }
+    assert( !_slots[id & _mask] );
+    _slots[id & _mask] = f;
+    ++_count;
+    _ctime_sum += f->ctime;
+  }
+
+  Flit * Find( int id ) const {
+    return ( id >= _base && id < _end ) ? _slots[id & _mask] : NULL;
+  }
+
+  // removes the entry of id and returns it
+  Flit * Remove( int id ) {
+    assert( id >= _base && id < _end );
+    Flit * const f = _slots[id & _mask];
+    assert( f );
+    _slots[id & _mask] = NULL;
+    --_count;
+    _ctime_sum -= f->ctime;
+    if ( _count == 0 ) {
+      _base = _end;
+    } else if ( id == _base ) {
+      while ( !_slots[_base & _mask] ) {
+	++_base;
+      }
+    }
+    return f;
+  }
+
+  bool empty( ) const { return _count == 0; }
+  int size( ) const { return _count; }
+
+  // sum of ( time - ctime ) over all entries
+  long long AgeSum( int time ) const {
+    return (long long)_count * time - _ctime_sum;
+  }
+
+  // lowest id in the table, -1 if empty
+  int First( ) const { return _count ? _base : -1; }
+  // lowest id in the table above id, -1 if none
+  int Next( int id ) const;
+
+};
+
+#endif
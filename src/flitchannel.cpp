@@ -45,9 +45,10 @@
 //  $Date: 2007/06/27 23:10:17 $
 //  $Id$
 // ----------------------------------------------------------------------
-FlitChannel::FlitChannel(Module * parent, string const & name, int classes)
-: Channel<Flit>(parent, name), _routerSource(NULL), _routerSourcePort(-1), 
-  _routerSink(NULL), _routerSinkPort(-1), _idle(0) {
+FlitChannel::FlitChannel(Module * parent, string const & name, int classes,
+			 ChannelBank * bank)
+: Channel<Flit>(parent, name, bank), _routerSource(NULL), _routerSourcePort(-1), 
+  _routerSink(NULL), _routerSinkPort(-1), _idle(0), _free_time(0), _watched(0) {
   _active.resize(classes, 0);
 }
 
@@ -61,9 +62,24 @@ void FlitChannel::SetSink(Router const * const router, int port) {
   _routerSinkPort = port;
 }
 
+/* the bank moves plain flits through the channel by itself; trains and
+ * watched flits need ReadInputs and WriteOutputs below, so the channel asks
+ * for them while it carries one of those or a train still holds it
+ */
+void FlitChannel::_UpdateHook() {
+  Flit const * const f = _Input();
+  bool const hook = (_watched > 0) || !_trains.empty() ||
+    (GetSimTime() + GetLatency() <= _free_time) ||
+    (f && (f->watch || (f->train > 1)));
+  _bank->SetHook(_index, hook);
+}
+
 void FlitChannel::Send(Flit * f) {
   if(f) {
-    ++_active[f->cl];
+    _active[f->cl] += f->train;
+    if(f->watch || (f->train > 1)) {
+      _bank->SetHook(_index, true);
+    }
   } else {
     ++_idle;
   }
@@ -71,21 +87,46 @@ void FlitChannel::Send(Flit * f) {
 }
 
 void FlitChannel::ReadInputs() {
-  Flit const * const & f = _input;
-  if(f && f->watch) {
-    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
-	       << "Beginning channel traversal for flit " << f->id
-	       << " with delay " << _delay
-	       << "." << endl;
+  Flit * const f = _Input();
+  if(f) {
+    if(f->watch) {
+      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+		 << "Beginning channel traversal for flit " << f->id
+		 << " with delay " << GetLatency()
+		 << "." << endl;
+      ++_watched;
+    }
+    // a flit train leaves with its first flit but occupies the channel
+    // for one cycle per flit it stands for; flits sent behind it wait
+    int const arrival = GetSimTime() + GetLatency() - 1;
+    int time = arrival;
+    if((f->train > 1) || (time < _free_time)) {
+      time = max(time, _free_time);
+      _free_time = time + f->train;
+    }
+    if((time > arrival) || !_trains.empty()) {
+      _trains.push_back(make_pair(time, f));
+      _SetInput(NULL);
+    }
   }
   Channel<Flit>::ReadInputs();
 }
 
 void FlitChannel::WriteOutputs() {
   Channel<Flit>::WriteOutputs();
-  if(_output && _output->watch) {
+  if(!_Output() && !_trains.empty()) {
+    assert(_trains.front().first >= GetSimTime());
+    if(_trains.front().first == GetSimTime()) {
+      _SetOutput(_trains.front().second);
+      _trains.pop_front();
+    }
+  }
+  Flit const * const f = _Output();
+  if(f && f->watch) {
     *gWatchOut << GetSimTime() << " | " << FullName() << " | "
-	       << "Completed channel traversal for flit " << _output->id
+	       << "Completed channel traversal for flit " << f->id
 	       << "." << endl;
+    --_watched;
   }
+  _UpdateHook();
 }
@@ -45,6 +45,7 @@
 
 #include "channel.hpp"
 #include "flit.hpp"
+#include "ringbuffer.hpp"
 
 using namespace std;
 
@@ -52,7 +53,8 @@ class Router ;
 
 class FlitChannel : public Channel<Flit> {
 public:
-  FlitChannel(Module * parent, string const & name, int classes);
+  FlitChannel(Module * parent, string const & name, int classes,
+	      ChannelBank * bank);
 
   void SetSource(Router const * const router, int port) ;
   inline Router const * const GetSource() const {
@@ -78,6 +80,10 @@ public:
   virtual void ReadInputs();
   virtual void WriteOutputs();
 
+  virtual bool IsIdle() const {
+    return Channel<Flit>::IsIdle() && _trains.empty();
+  }
+
 private:
   
   ////////////////////////////////////////
@@ -94,6 +100,17 @@ private:
   // Statistics for Activity Factors
   vector<int> _active;
   int _idle;
+
+  // first cycle in which the next flit can leave the channel after a
+  // flit train
+  int _free_time;
+  // flits that leave later than the channel latency because a train holds
+  // the channel, with the cycle they leave in
+  RingBuffer<pair<int, Flit *> > _trains;
+  // watched flits in the channel
+  int _watched;
+
+  void _UpdateHook();
 };
 
 #endif
@@ -0,0 +1,584 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include "booksim.hpp"
+#include "flowtrafficmanager.hpp"
+#include "collective.hpp"
+#include "polarfly_tables.hpp"
+#include "network.hpp"
+#include "flitchannel.hpp"
+#include "outputset.hpp"
+#include "router.hpp"
+#include "traffic.hpp"
+
+FlowTrafficManager::FlowTrafficManager( const Configuration &config,
+					const vector<Network *> & net )
+  : CollectiveTrafficManager(config, net), _reallocate(false), _flow_end(0.0)
+{
+  if ( gCollective == COLLECTIVE_NONE ) {
+    Error("The flow model needs a collective (pairwise, ring or a schedule).");
+  }
+  // the steps of other patterns send each packet somewhere else
+  if ( !_schedule &&
+       !dynamic_cast<PairwiseTrafficPattern *>(_traffic_pattern[0]) &&
+       !dynamic_cast<RingTrafficPattern *>(_traffic_pattern[0]) ) {
+    Error("The flow model needs the pairwise or ring pattern or a collective schedule.");
+  }
+  if ( _subnets > 1 ) {
+    Error("The flow model only supports a single subnet.");
+  }
+  _cycle_ns = config.GetFloat( "flow_cycle_ns" );
+  _routing_delay = config.GetInt( "routing_delay" );
+  int const vc_alloc_delay = config.GetInt( "vc_alloc_delay" );
+  int const sw_alloc_delay = config.GetInt( "sw_alloc_delay" );
+  int const alloc_delay = ( config.GetInt( "speculative" ) > 0 ) ?
+    max(vc_alloc_delay, sw_alloc_delay) : ( vc_alloc_delay + sw_alloc_delay );
+  // the zero-load delay of a flit through an input-queued router
+  _router_delay = 1 + _routing_delay + alloc_delay +
+    config.GetInt( "st_prepare_delay" ) + config.GetInt( "st_final_delay" );
+  _packet_flits = _GetAveragePacketSize( 0 );
+}
+
+FlowTrafficManager::~FlowTrafficManager( )
+{
+}
+
+int FlowTrafficManager::_ChannelId( FlitChannel const * c )
+{
+  map<FlitChannel const *, int>::const_iterator iter = _channel_ids.find(c);
+  if ( iter != _channel_ids.end( ) ) {
+    return iter->second;
+  }
+  int const id = _channel_ids.size( );
+  _channel_ids[c] = id;
+  return id;
+}
+
+// Follows a head flit from src to dest through the network, asking the
+// routing function of every router on the way for its output. The first
+// (highest priority) output is taken, so adaptive routing functions are
+// followed along their preferred route.
+FlowTrafficManager::FlowPath const & FlowTrafficManager::_Path( int src, int dest )
+{
+  pair<int, int> const key(src, dest);
+  map<pair<int, int>, FlowPath>::const_iterator iter = _paths.find(key);
+  if ( iter != _paths.end( ) ) {
+    return iter->second;
+  }
+  FlowPath & path = _paths[key];
+
+  Flit * f = Flit::New( );
+  f->id = -1;
+  f->pid = -1;
+  f->src = src;
+  f->dest = dest;
+  f->cl = 0;
+  f->head = true;
+  f->tail = true;
+  f->type = Flit::ANY_TYPE;
+  f->ctime = _time;
+
+  OutputSet route_set;
+  _rf( NULL, f, -1, &route_set, true );
+  if ( route_set.GetSet( ).empty( ) ) {
+    Error("No injection VC for the flow model.");
+  }
+  f->vc = route_set.GetSet( ).begin( )->vc_start;
+
+  // the step counters must not see the traced flit
+  CollectiveAlgorithm const collective = gCollective;
+  gCollective = COLLECTIVE_NONE;
+
+  FlitChannel const * channel = _net[0]->GetInject(src);
+  double latency = 0.0;
+  int const max_hops = 4 * _routers + 4;
+  for ( int hops = 0; ; ++hops ) {
+    path.channels.push_back(_ChannelId(channel));
+    latency += channel->GetLatency( );
+    Router const * const router = channel->GetSink( );
+    if ( !router ) {
+      break;
+    }
+    if ( hops > max_hops ) {
+      gCollective = collective;
+      ostringstream err;
+      err << "The route from " << src << " to " << dest << " does not reach its destination.";
+      Error(err.str());
+    }
+    _rf( router, f, channel->GetSinkPort( ), &route_set, false );
+    if ( route_set.GetSet( ).empty( ) ) {
+      gCollective = collective;
+      Error("The routing function returned no output for the flow model.");
+    }
+    OutputSet::sSetElement const & out = *route_set.GetSet( ).begin( );
+    f->vc = out.vc_start;
+    ++f->hops;
+    channel = router->GetOutputChannel(out.output_port);
+    if ( !channel->GetSink( ) ) {
+      path.rx_latency = latency + _routing_delay;
+    }
+    latency += _router_delay;
+  }
+  gCollective = collective;
+  f->Free( );
+
+  if ( channel != _net[0]->GetEject(dest) ) {
+    ostringstream err;
+    err << "The route from " << src << " to " << dest << " ejects at the wrong node.";
+    Error(err.str());
+  }
+  path.latency = latency;
+  return path;
+}
+
+// Lists, for every node and step, where the node sends to and how much,
+// following the step structure of CollectiveTrafficManager.
+void FlowTrafficManager::_BuildSteps( )
+{
+  int const step_flits = _step_threshold * _packet_flits;
+  _send_dest.assign(_nodes, vector<int>());
+  _send_flits.assign(_nodes, vector<double>());
+  int steps = 0;
+  for ( int node = 0; node < _nodes; ++node ) {
+    int const row = gSingleSwitch ? 0 : ( node / _nics );
+    int const nic = gSingleSwitch ? node : ( node % _nics );
+    int node_steps;
+    if ( _schedule ) {
+      node_steps = _schedule->Steps( );
+    } else if ( gCollective == COLLECTIVE_PAIRWISE ) {
+      if ( gSingleSwitch ) {
+        node_steps = 0;
+        while ( ( 1 << node_steps ) < _nodes ) {
+          ++node_steps;
+        }
+      } else {
+        node_steps = _max_step_threshold + nic;
+      }
+    } else {
+      node_steps = max(0, 2 * (_nodes - 1) * (_chunk / _nodes) - 1);
+    }
+    _send_dest[node].resize(node_steps, -1);
+    _send_flits[node].resize(node_steps, 0.0);
+    for ( int step = 0; step < node_steps; ++step ) {
+      int dest;
+      double flits = step_flits;
+      if ( _schedule ) {
+        dest = _schedule->dest(node, step);
+        flits *= _schedule->TxBlocks(node, step);
+      } else {
+        step_table[row][nic] = step;
+        dest = _traffic_pattern[0]->dest(node);
+        // pairwise steps without a partner are skipped
+        if ( dest >= _nodes ) {
+          dest = -1;
+        }
+      }
+      if ( ( dest >= 0 ) &&
+           ( fault_nodes[node / _nics] || fault_nodes[dest / _nics] ) ) {
+        dest = -1;
+      }
+      _send_dest[node][step] = dest;
+      _send_flits[node][step] = ( dest < 0 ) ? 0.0 : flits;
+    }
+    step_table[row][nic] = 0;
+    steps = max(steps, node_steps);
+  }
+
+  _rx_pending.assign(_nodes, vector<int>(steps, 0));
+  for ( int node = 0; node < _nodes; ++node ) {
+    for ( size_t step = 0; step < _send_dest[node].size( ); ++step ) {
+      int const dest = _send_dest[node][step];
+      if ( dest >= 0 ) {
+        if ( step >= _rx_pending[dest].size( ) ) {
+          ostringstream err;
+          err << "Node " << dest << " receives in step " << step << " after its last step.";
+          Error(err.str());
+        }
+        ++_rx_pending[dest][step];
+      }
+    }
+  }
+  _flow_step_done.assign(steps, 0.0);
+}
+
+void FlowTrafficManager::_PushEvent( double time, EventType type, int node,
+				     int step, double rate )
+{
+  Event e;
+  e.time = time;
+  e.type = type;
+  e.node = node;
+  e.step = step;
+  e.rate = rate;
+  _events.push(e);
+}
+
+// The source router only counts what it receives while the rx step of the
+// NIC has caught up with its tx step.
+bool FlowTrafficManager::_TxCounting( int node ) const
+{
+  int const steps = _send_dest[node].size( );
+  return ( _node_tx[node] < steps ) && ( _node_rx[node] >= _node_tx[node] );
+}
+
+// Flits the source router has to count before the tx step is done: up to
+// the head of the last packet of the step, none for a step without a send.
+double FlowTrafficManager::_TxTarget( int node ) const
+{
+  int const step = _node_tx[node];
+  if ( _send_dest[node][step] < 0 ) {
+    return 0.0;
+  }
+  return max(1.0, _send_flits[node][step] - _packet_flits + 1.0);
+}
+
+void FlowTrafficManager::_StartFlow( int node, int step, double now )
+{
+  Flow flow;
+  flow.src = node;
+  flow.dest = _send_dest[node][step];
+  flow.step = step;
+  // the pairwise and ring patterns inject until the tx step moves on,
+  // schedules issue the packets of the step only
+  flow.size = _schedule ? _send_flits[node][step] : numeric_limits<double>::infinity( );
+  flow.count_at = max(1.0, _send_flits[node][step] - _packet_flits + 1.0);
+  flow.sent = 0.0;
+  flow.rate = 0.0;
+  flow.counted = false;
+  flow.path = &_Path(node, flow.dest);
+  _node_sending[node] = step;
+  // a source injects its packets in order, so the flow waits until the
+  // flow of the previous step is injected
+  if ( _node_injecting[node] ) {
+    _waiting.push_back(flow);
+  } else {
+    _flows.push_back(flow);
+    _node_injecting[node] = true;
+    _reallocate = true;
+  }
+}
+
+// The NIC stops injecting once the packet it is sending is complete, but
+// not before the packets of the step are. The sizes are fixed by
+// _FixStoppedFlows once the events of the current time are handled.
+void FlowTrafficManager::_StopFlow( int node )
+{
+  _node_stopped[node] = true;
+  _stopped = true;
+  _node_sending[node] = -1;
+}
+
+void FlowTrafficManager::_FixStoppedFlows( )
+{
+  for ( int list = 0; list < 2; ++list ) {
+    vector<Flow> & flows = list ? _waiting : _flows;
+    for ( size_t i = 0; i < flows.size( ); ++i ) {
+      Flow & flow = flows[i];
+      if ( _node_stopped[flow.src] && ( flow.size == numeric_limits<double>::infinity( ) ) ) {
+        flow.size = max(_send_flits[flow.src][flow.step],
+                        ceil(flow.sent / _packet_flits - 1e-9) * _packet_flits);
+      }
+    }
+  }
+  _node_stopped.assign(_nodes, false);
+  _stopped = false;
+}
+
+// Moves the step counters of a node as far as they go and starts or stops
+// its injection like the traffic manager does for the step it is in.
+void FlowTrafficManager::_Update( int node, double now )
+{
+  int const steps = _send_dest[node].size( );
+  int const old_step = min(_node_tx[node], _node_rx[node]);
+  while ( true ) {
+    if ( _TxCounting( node ) && ( _tx_counted[node] >= _TxTarget( node ) - 1e-9 ) ) {
+      ++_node_tx[node];
+      _tx_counted[node] = 0.0;
+      continue;
+    }
+    if ( ( _node_rx[node] < steps ) && ( _rx_pending[node][_node_rx[node]] == 0 ) ) {
+      ++_node_rx[node];
+      continue;
+    }
+    break;
+  }
+  int const step = min(_node_tx[node], _node_rx[node]);
+  for ( int s = old_step; s < step; ++s ) {
+    _flow_step_done[s] = max(_flow_step_done[s], now);
+  }
+  if ( ( step >= steps ) && ( _node_done[node] < 0.0 ) ) {
+    _node_done[node] = now;
+  }
+  bool const send = _node_started[node] && ( step < steps ) && ( step >= _node_tx[node] );
+  if ( ( _node_sending[node] >= 0 ) && ( !send || ( _node_sending[node] != step ) ) ) {
+    _StopFlow( node );
+  }
+  if ( send && ( _node_sending[node] < 0 ) && ( _send_dest[node][step] >= 0 ) ) {
+    _StartFlow( node, step, now );
+  }
+
+  bool const counting = ( _arrival_rate[node] > 0.0 ) && _TxCounting( node );
+  if ( counting && ( _counting_pos[node] < 0 ) ) {
+    _counting_pos[node] = _counting.size( );
+    _counting.push_back(node);
+  } else if ( !counting && ( _counting_pos[node] >= 0 ) ) {
+    int const last = _counting.back( );
+    _counting[_counting_pos[node]] = last;
+    _counting_pos[last] = _counting_pos[node];
+    _counting.pop_back( );
+    _counting_pos[node] = -1;
+  }
+}
+
+// Max-min fair rates by progressive filling: the channel that offers its
+// flows the smallest equal share fixes the rate of those flows, and their
+// share is taken off the other channels they cross.
+void FlowTrafficManager::_AllocateRates( )
+{
+  int const channels = _channel_ids.size( );
+  if ( (int)_channel_flows.size( ) < channels ) {
+    _channel_flows.resize(channels);
+    _capacity.resize(channels);
+    _count.resize(channels);
+  }
+  // only the channels the flows cross are looked at
+  vector<int> used;
+  for ( size_t i = 0; i < _flows.size( ); ++i ) {
+    vector<int> const & path = _flows[i].path->channels;
+    for ( size_t h = 0; h < path.size( ); ++h ) {
+      if ( _channel_flows[path[h]].empty( ) ) {
+        used.push_back(path[h]);
+      }
+      _channel_flows[path[h]].push_back(i);
+    }
+  }
+
+  for ( size_t u = 0; u < used.size( ); ++u ) {
+    int const c = used[u];
+    _capacity[c] = 1.0;
+    _count[c] = _channel_flows[c].size( );
+  }
+
+  // every round fixes the flows of the channels with the smallest share
+  vector<bool> fixed(_flows.size( ), false);
+  vector<int> active(used);
+  while ( !active.empty( ) ) {
+    double share = numeric_limits<double>::infinity( );
+    for ( size_t a = 0; a < active.size( ); ++a ) {
+      share = min(share, _capacity[active[a]] / _count[active[a]]);
+    }
+    double const bound = share * ( 1.0 + 1e-9 );
+    for ( size_t a = 0; a < active.size( ); ++a ) {
+      int const c = active[a];
+      if ( ( _count[c] == 0 ) || ( _capacity[c] / _count[c] > bound ) ) {
+        continue;
+      }
+      for ( size_t i = 0; i < _channel_flows[c].size( ); ++i ) {
+        int const flow = _channel_flows[c][i];
+        if ( fixed[flow] ) {
+          continue;
+        }
+        fixed[flow] = true;
+        _flows[flow].rate = share;
+        vector<int> const & path = _flows[flow].path->channels;
+        for ( size_t h = 0; h < path.size( ); ++h ) {
+          _capacity[path[h]] = max(0.0, _capacity[path[h]] - share);
+          --_count[path[h]];
+        }
+      }
+    }
+    size_t left = 0;
+    for ( size_t a = 0; a < active.size( ); ++a ) {
+      if ( _count[active[a]] > 0 ) {
+        active[left++] = active[a];
+      }
+    }
+    active.resize(left);
+  }
+
+  for ( size_t u = 0; u < used.size( ); ++u ) {
+    _channel_flows[used[u]].clear( );
+  }
+}
+
+bool FlowTrafficManager::_SingleSim( )
+{
+  _BuildSteps( );
+  _node_tx.assign(_nodes, 0);
+  _node_rx.assign(_nodes, 0);
+  _node_started.assign(_nodes, false);
+  _tx_counted.assign(_nodes, 0.0);
+  _arrival_rate.assign(_nodes, 0.0);
+  _counting.clear( );
+  _counting_pos.assign(_nodes, -1);
+  _inject_rate.assign(_nodes, 0.0);
+  _tx_latency.resize(_nodes);
+  _node_sending.assign(_nodes, -1);
+  _node_injecting.assign(_nodes, false);
+  _node_done.assign(_nodes, -1.0);
+  _node_stopped.assign(_nodes, false);
+  _stopped = false;
+  _flows.clear( );
+  _waiting.clear( );
+  while ( !_events.empty( ) ) {
+    _events.pop( );
+  }
+  _flow_end = 0.0;
+  for ( int node = 0; node < _nodes; ++node ) {
+    _tx_latency[node] = _net[0]->GetInject(node)->GetLatency( ) + _routing_delay;
+    _PushEvent(delay_table[node / _nics], NODE_START, node);
+  }
+
+  double now = 0.0;
+  double const inf = numeric_limits<double>::infinity( );
+  vector<Flow> started;
+  vector<int> counted;
+  vector<double> inject_rate(_nodes);
+  while ( true ) {
+    if ( _reallocate ) {
+      _AllocateRates( );
+      _reallocate = false;
+      // the source router sees a new injection rate one latency later
+      inject_rate.assign(_nodes, 0.0);
+      for ( size_t i = 0; i < _flows.size( ); ++i ) {
+        inject_rate[_flows[i].src] = _flows[i].rate;
+      }
+      for ( int node = 0; node < _nodes; ++node ) {
+        if ( inject_rate[node] != _inject_rate[node] ) {
+          _inject_rate[node] = inject_rate[node];
+          _PushEvent(now + _tx_latency[node], ARRIVAL_RATE, node, 0, inject_rate[node]);
+        }
+      }
+    }
+    double next = _events.empty( ) ? inf : _events.top( ).time;
+    for ( size_t i = 0; i < _flows.size( ); ++i ) {
+      Flow const & flow = _flows[i];
+      double const target = flow.counted ? flow.size : flow.count_at;
+      if ( target < inf ) {
+        next = min(next, now + ( target - flow.sent ) / flow.rate);
+      }
+    }
+    for ( size_t i = 0; i < _counting.size( ); ++i ) {
+      int const node = _counting[i];
+      next = min(next, now + max(0.0, _TxTarget( node ) - _tx_counted[node]) / _arrival_rate[node]);
+    }
+    if ( next == inf ) {
+      break;
+    }
+    next = max(next, now);
+    double const elapsed = next - now;
+    now = next;
+    // events closer than this are taken to happen at the same time
+    double const eps = 1e-9 * max(1.0, now);
+
+    for ( size_t i = 0; i < _counting.size( ); ++i ) {
+      int const node = _counting[i];
+      _tx_counted[node] += _arrival_rate[node] * elapsed;
+      if ( _tx_counted[node] >= _TxTarget( node ) - eps ) {
+        _tx_counted[node] = _TxTarget( node );
+        counted.push_back(node);
+      }
+    }
+    for ( size_t i = 0; i < counted.size( ); ++i ) {
+      _Update( counted[i], now );
+    }
+    counted.clear( );
+
+    size_t active = 0;
+    for ( size_t i = 0; i < _flows.size( ); ++i ) {
+      Flow & flow = _flows[i];
+      flow.sent += flow.rate * elapsed;
+      if ( !flow.counted && ( flow.sent >= flow.count_at - eps ) ) {
+        flow.counted = true;
+        _PushEvent(now + flow.path->rx_latency, RX_DONE, flow.dest, flow.step);
+      }
+      if ( flow.counted && ( flow.sent >= flow.size - eps ) ) {
+        _flow_end = max(_flow_end, now + flow.path->latency);
+        _node_injecting[flow.src] = false;
+        _reallocate = true;
+        for ( size_t w = 0; w < _waiting.size( ); ++w ) {
+          if ( _waiting[w].src == flow.src ) {
+            started.push_back(_waiting[w]);
+            _waiting.erase(_waiting.begin( ) + w);
+            _node_injecting[flow.src] = true;
+            break;
+          }
+        }
+        continue;
+      }
+      _flows[active++] = flow;
+    }
+    _flows.resize(active);
+    _flows.insert(_flows.end( ), started.begin( ), started.end( ));
+    started.clear( );
+
+    while ( !_events.empty( ) && ( _events.top( ).time <= now + eps ) ) {
+      Event const e = _events.top( );
+      _events.pop( );
+      if ( e.type == NODE_START ) {
+        _node_started[e.node] = true;
+      } else if ( e.type == RX_DONE ) {
+        --_rx_pending[e.node][e.step];
+      } else {
+        _arrival_rate[e.node] = e.rate;
+      }
+      _Update(e.node, now);
+    }
+    if ( _stopped ) {
+      _FixStoppedFlows( );
+    }
+  }
+
+  for ( int node = 0; node < _nodes; ++node ) {
+    if ( _node_done[node] < 0.0 ) {
+      ostringstream err;
+      err << "Node " << node << " did not complete step "
+          << min(_node_tx[node], _node_rx[node]) << " in the flow model.";
+      Error(err.str());
+    }
+    _flow_end = max(_flow_end, _node_done[node]);
+  }
+  _time = (int)ceil(_flow_end);
+  return true;
+}
+
+void FlowTrafficManager::DisplayOverallStats( ostream & os ) const
+{
+  double const ms = _cycle_ns * 1e-6;
+  os << "====== Flow model ======" << endl;
+  os << "Collective step completion times:" << endl;
+  for ( size_t step = 0; step < _flow_step_done.size( ); ++step ) {
+    os << "##step" << step << " : " << _flow_step_done[step] << " cycles ("
+       << _flow_step_done[step] * ms << " ms)" << endl;
+  }
+  os << "Collective completion time = " << _flow_end << " cycles ("
+     << _flow_end * ms << " ms)" << endl;
+}
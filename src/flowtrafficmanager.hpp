@@ -0,0 +1,157 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _FLOWTRAFFICMANAGER_HPP_
+#define _FLOWTRAFFICMANAGER_HPP_
+
+#include <iostream>
+#include <map>
+#include <queue>
+
+#include "config_utils.hpp"
+#include "collectivetrafficmanager.hpp"
+
+class FlitChannel;
+
+// Estimates the completion time of a collective without simulating flits.
+// Every transfer of a step is a flow over the channels the routing function
+// picks for its head flit, and the flows being injected share the channels
+// by max-min fairness at one flit per cycle. The step counters of a NIC
+// move like the router counters of the cycle-accurate run: the source
+// router counts whatever it receives from the NIC, one injection latency
+// after it was sent, and the destination router counts the flows of a step
+// once their last packet arrives.
+class FlowTrafficManager : public CollectiveTrafficManager {
+
+protected:
+
+  struct FlowPath {
+    vector<int> channels;
+    // cycles until the head flit is routed at the destination router and
+    // until it is ejected
+    double rx_latency;
+    double latency;
+  };
+
+  struct Flow {
+    int src;
+    int dest;
+    int step;
+    // flits, infinite while the source keeps injecting
+    double size;
+    // the destination counts the flow once its last packet has started
+    double count_at;
+    double sent;
+    double rate;
+    bool counted;
+    FlowPath const * path;
+  };
+
+  enum EventType { NODE_START, RX_DONE, ARRIVAL_RATE };
+  struct Event {
+    double time;
+    EventType type;
+    int node;
+    int step;
+    double rate;
+    bool operator>( Event const & e ) const { return time > e.time; }
+  };
+
+  double _cycle_ns;
+  double _router_delay;
+  int _routing_delay;
+  double _packet_flits;
+
+  map<pair<int, int>, FlowPath> _paths;
+  map<FlitChannel const *, int> _channel_ids;
+
+  // per node and step: destination (-1: none) and flits sent
+  vector<vector<int> > _send_dest;
+  vector<vector<double> > _send_flits;
+  // flows of a step a node still waits for
+  vector<vector<int> > _rx_pending;
+
+  vector<int> _node_tx;
+  vector<int> _node_rx;
+  vector<bool> _node_started;
+  // flits the source router counted for the tx step, the rate they arrive
+  // at and the rate the NIC injects at
+  vector<double> _tx_counted;
+  vector<double> _arrival_rate;
+  vector<double> _inject_rate;
+  vector<double> _tx_latency;
+  // NICs whose source router is counting arriving flits, and their index
+  // in the list (-1 if not in it)
+  vector<int> _counting;
+  vector<int> _counting_pos;
+  // step the NIC injects for, -1 if it does not inject
+  vector<int> _node_sending;
+  vector<bool> _node_injecting;
+  // NICs that stopped injecting since the stopped flows were last sized
+  vector<bool> _node_stopped;
+  bool _stopped;
+  vector<double> _node_done;
+
+  // flows that are injected and flows queued behind them at their source
+  vector<Flow> _flows;
+  vector<Flow> _waiting;
+  bool _reallocate;
+  priority_queue<Event, vector<Event>, greater<Event> > _events;
+
+  // per channel: flows crossing it, capacity left and flows without a
+  // rate, used by _AllocateRates
+  vector<vector<int> > _channel_flows;
+  vector<double> _capacity;
+  vector<int> _count;
+
+  vector<double> _flow_step_done;
+  double _flow_end;
+
+  FlowPath const & _Path( int src, int dest );
+  int _ChannelId( FlitChannel const * c );
+  void _BuildSteps( );
+  bool _TxCounting( int node ) const;
+  double _TxTarget( int node ) const;
+  void _StartFlow( int node, int step, double now );
+  void _StopFlow( int node );
+  void _FixStoppedFlows( );
+  void _Update( int node, double now );
+  void _AllocateRates( );
+  void _PushEvent( double time, EventType type, int node, int step = 0, double rate = 0.0 );
+
+  virtual bool _SingleSim( );
+
+public:
+
+  FlowTrafficManager( const Configuration &config, const vector<Network *> & net );
+  virtual ~FlowTrafficManager( );
+
+  virtual void DisplayOverallStats( ostream & os = cout ) const;
+
+};
+
+#endif
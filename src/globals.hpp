@@ -50,4 +50,7 @@ extern bool gTrace;
 
 extern std::ostream * gWatchOut;
 
+class EventTrace;
+extern EventTrace * gEventTrace;
+
 #endif
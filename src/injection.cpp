@@ -53,6 +53,14 @@ void InjectionProcess::reset()
 
 }
 
+void InjectionProcess::Seed(long seed, int index)
+{
+  _streams.resize(_nodes);
+  for(int n = 0; n < _nodes; ++n) {
+    _streams[n].Seed(seed, RandomStream::injection, index * _nodes + n);
+  }
+}
+
 InjectionProcess * InjectionProcess::New(string const & inject, int nodes, 
 					 double load, 
 					 Configuration const * const config)
@@ -143,7 +151,23 @@ BernoulliInjectionProcess::BernoulliInjectionProcess(int nodes, double rate)
 bool BernoulliInjectionProcess::test(int source)
 {
   assert((source >= 0) && (source < _nodes));
-  return (RandomFloat() < _rate);
+  if(_streams.empty()) {
+    return (RandomFloat() < _rate);
+  }
+  int & next = _next[source];
+  double * const draws = &_draws[source * kBatch];
+  if(next == kBatch) {
+    _streams[source].Floats(draws, kBatch);
+    next = 0;
+  }
+  return (draws[next++] < _rate);
+}
+
+void BernoulliInjectionProcess::Seed(long seed, int index)
+{
+  InjectionProcess::Seed(seed, index);
+  _draws.assign(_nodes * kBatch, 0.0);
+  _next.assign(_nodes, kBatch);
 }
 
 //=============================================================
@@ -183,8 +207,8 @@ bool OnOffInjectionProcess::test(int source)
 
   // advance state
   _state[source] = 
-    _state[source] ? (RandomFloat() >= _beta) : (RandomFloat() < _alpha);
+    _state[source] ? (_Uniform(source) >= _beta) : (_Uniform(source) < _alpha);
 
   // generate packet
-  return _state[source] && (RandomFloat() < _r1);
+  return _state[source] && (_Uniform(source) < _r1);
 }
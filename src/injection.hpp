@@ -29,6 +29,7 @@
 #define _INJECTION_HPP_
 
 #include "config_utils.hpp"
+#include "random_utils.hpp"
 
 using namespace std;
 
@@ -36,19 +37,33 @@ class InjectionProcess {
 protected:
   int _nodes;
   double _rate;
+  // one stream per node with rng = stream, empty otherwise
+  vector<RandomStream> _streams;
   InjectionProcess(int nodes, double rate);
+  inline double _Uniform(int source) {
+    return _streams.empty() ? RandomFloat() : _streams[source].Float();
+  }
 public:
   virtual ~InjectionProcess() {}
   virtual bool test(int source) = 0;
   virtual void reset();
+  // gives every node a stream of its own; index tells the processes of the
+  // traffic classes apart
+  virtual void Seed(long seed, int index);
   static InjectionProcess * New(string const & inject, int nodes, double load, 
 				Configuration const * const config = NULL);
 };
 
 class BernoulliInjectionProcess : public InjectionProcess {
+private:
+  // draws of every node, generated kBatch at a time
+  static int const kBatch = 16;
+  vector<double> _draws;
+  vector<int> _next;
 public:
   BernoulliInjectionProcess(int nodes, double rate);
   virtual bool test(int source);
+  virtual void Seed(long seed, int index);
 };
 
 class OnOffInjectionProcess : public InjectionProcess {
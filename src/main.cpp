@@ -53,6 +53,9 @@
 #include "network.hpp"
 #include "injection.hpp"
 #include "power_module.hpp"
+#include "collective.hpp"
+#include "event_trace.hpp"
+#include "sweep.hpp"
 
 
 
@@ -108,7 +111,6 @@ bool Simulate( BookSimConfig const & config )
     name << "network_" << i;
     net[i] = Network::New( config, name.str() );
   }
-
   /*tcc and characterize are legacy
    *not sure how to use them 
    */
@@ -166,9 +168,17 @@ int main( int argc, char **argv )
   /*initialize routing, traffic, injection functions
    */
   InitializeRoutingMap( config );
+  InitializeCollective( config );
 
   gPrintActivity = (config.GetInt("print_activity") > 0);
   gTrace = (config.GetInt("viewer_trace") > 0);
+
+  string const rng = config.GetStr( "rng" );
+  if ( ( rng != "knuth" ) && ( rng != "stream" ) ) {
+    cout << "Error: unknown rng: " << rng << endl;
+    exit(-1);
+  }
+  gRandomStreams = ( rng == "stream" );
   
   string watch_out_file = config.GetStr( "watch_out" );
   if(watch_out_file == "") {
@@ -178,10 +188,17 @@ int main( int argc, char **argv )
   } else {
     gWatchOut = new ofstream(watch_out_file.c_str());
   }
+
+  string event_trace_file = config.GetStr( "event_trace_out" );
+  if(event_trace_file != "") {
+    gEventTrace = new EventTrace(event_trace_file);
+  }
   
 
   /*configure and run the simulator
    */
-  bool result = Simulate( config );
+  bool result = SweepRequested( config ) ? Sweep( config ) : Simulate( config );
+  delete gEventTrace;
+  gEventTrace = NULL;
   return result ? -1 : 0;
 }
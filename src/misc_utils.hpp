@@ -31,4 +31,36 @@
 int log_two( int x );
 int powi( int x, int y );
 
+// multi-word bit masks: bit i is bit ( i % 64 ) of word ( i / 64 )
+
+inline int mask_words( int bits )
+{
+  return ( bits + 63 ) / 64;
+}
+
+// lowest set bit at or above from, -1 if none
+inline int mask_first( const unsigned long long * w, int words, int from )
+{
+  int i = from >> 6;
+  if ( i >= words ) {
+    return -1;
+  }
+  unsigned long long b = w[i] & ( ~0ULL << ( from & 63 ) );
+  while ( !b ) {
+    if ( ++i == words ) {
+      return -1;
+    }
+    b = w[i];
+  }
+  return ( i << 6 ) + __builtin_ctzll( b );
+}
+
+// lowest set bit at or above from, else the lowest set bit below it
+// (round-robin order starting at from), -1 if none
+inline int mask_first_wrap( const unsigned long long * w, int words, int from )
+{
+  int const b = mask_first( w, words, from );
+  return ( ( b < 0 ) && ( from > 0 ) ) ? mask_first( w, words, 0 ) : b;
+}
+
 #endif 
@@ -55,6 +55,7 @@
 #include <sstream>
 #include <limits>
 #include <algorithm>
+#include <set>
 //this is a hack, I can't easily get the routing talbe out of the network
 map<int, int>* global_routing_table;
 
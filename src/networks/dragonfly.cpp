@@ -35,8 +35,6 @@
 #include "misc_utils.hpp"
 #include "globals.hpp"
 
-//#define DRAGON_LATENCY
-
 int gP, gA, gG;
 
 //calculate the hop count between src and estination
@@ -221,6 +219,9 @@ void DragonFlyNew::_BuildNet( const Configuration &config )
   int _num_ports_per_switch=-1;
   int c;
 
+  // 10 cycles for the channels inside a group, 100 between groups
+  bool const dragon_latency = ( config.GetInt( "dragonfly_latency" ) > 0 );
+
   ostringstream router_name;
 
 
@@ -280,10 +281,10 @@ void DragonFlyNew::_BuildNet( const Configuration &config )
 
 	_routers[node]->AddOutputChannel( _chan[_output], _chan_cred[_output] );
 
-#ifdef DRAGON_LATENCY
-	_chan[_output]->SetLatency(10);
-	_chan_cred[_output]->SetLatency(10);
-#endif
+	if ( dragon_latency ) {
+	  _chan[_output]->SetLatency(10);
+	  _chan_cred[_output]->SetLatency(10);
+	}
       }
     }
 
@@ -294,10 +295,10 @@ void DragonFlyNew::_BuildNet( const Configuration &config )
 
       //      _chan[_output].global = true;
       _routers[node]->AddOutputChannel( _chan[_output], _chan_cred[_output] );
-#ifdef DRAGON_LATENCY
-      _chan[_output]->SetLatency(100);
-      _chan_cred[_output]->SetLatency(100);
-#endif
+      if ( dragon_latency ) {
+	_chan[_output]->SetLatency(100);
+	_chan_cred[_output]->SetLatency(100);
+      }
     }
 
 
@@ -103,6 +103,9 @@ void FatTree::_BuildNet( const Configuration& config )
   // Number of router positions at each depth of the network
   const int nPos = powi( _k, _n-1);
 
+  const int nic_latency = config.GetInt( "nic_latency" ) > 0 ? config.GetInt( "nic_latency" ) : 1;
+  const int channel_latency = config.GetInt( "channel_latency" ) > 0 ? config.GetInt( "channel_latency" ) : 1;
+
   //
   // Allocate Routers
   //
@@ -145,10 +148,10 @@ void FatTree::_BuildNet( const Configuration& config )
 					    _inject_cred[link]);
       _Router( _n-1, pos)->AddOutputChannel( _eject[link],
 					     _eject_cred[link]);
-      _inject[link]->SetLatency( 1 );
-      _inject_cred[link]->SetLatency( 1 );
-      _eject[link]->SetLatency( 1 );
-      _eject_cred[link]->SetLatency( 1 );
+      _inject[link]->SetLatency( nic_latency );
+      _inject_cred[link]->SetLatency( nic_latency );
+      _eject[link]->SetLatency( nic_latency );
+      _eject_cred[link]->SetLatency( nic_latency );
     }
   }
 
@@ -168,8 +171,8 @@ void FatTree::_BuildNet( const Configuration& config )
 	int link = (level*chan_per_level) + pos*_k + port;
 	_Router(level, pos)->AddOutputChannel( _chan[link],
 						_chan_cred[link] );
-	_chan[link]->SetLatency( 1 );
-	_chan_cred[link]->SetLatency( 1 ); 
+	_chan[link]->SetLatency( channel_latency );
+	_chan_cred[link]->SetLatency( channel_latency ); 
 #ifdef FATTREE_DEBUG
 	cout<<_Router(level, pos)->Name()<<" "
 	    <<"down output "<<port<<" "
@@ -187,8 +190,8 @@ void FatTree::_BuildNet( const Configuration& config )
 	int link = (level*chan_per_level - chan_per_direction) + pos*_k + port ;
 	_Router(level, pos)->AddOutputChannel( _chan[link],
 						_chan_cred[link] );
-	_chan[link]->SetLatency( 1 );
-	_chan_cred[link]->SetLatency( 1 ); 
+	_chan[link]->SetLatency( channel_latency );
+	_chan_cred[link]->SetLatency( channel_latency ); 
 #ifdef FATTREE_DEBUG
 	cout<<_Router(level, pos)->Name()<<" "
 	    <<"up output "<<port<<" "
@@ -243,7 +243,7 @@ void HCube::InsertRandomFaults( const Configuration &config )
     } else {
       fail_seed = config.GetInt( "fail_seed" );
     }
-    RandomSeed( fail_seed );
+    RandomFaultScope faults( fail_seed );
 
     vector<bool> fail_nodes(_size);
 
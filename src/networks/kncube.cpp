@@ -57,11 +57,14 @@ void KNCube::_ComputeSize( const Configuration &config )
   _k = config.GetInt( "k" );
   _n = config.GetInt( "n" );
 
+  _nic = config.GetInt( "nic" );
+
   gK = _k; gN = _n;
   _size     = powi( _k, _n );
   _channels = 2*_n*_size;
 
-  _nodes = _size;
+  // the nodes of a router are numbered consecutively
+  _nodes = _size * _nic;
 }
 
 void KNCube::RegisterRoutingFunctions() {
@@ -83,6 +86,9 @@ void KNCube::_BuildNet( const Configuration &config )
   //latency type, noc or conventional network
   bool use_noc_latency;
   use_noc_latency = (config.GetInt("use_noc_latency")==1);
+
+  int const channel_latency = config.GetInt( "channel_latency" );
+  int const nic_latency = config.GetInt( "nic_latency" ) > 0 ? config.GetInt( "nic_latency" ) : 1;
   
   for ( int node = 0; node < _size; ++node ) {
 
@@ -95,7 +101,7 @@ void KNCube::_BuildNet( const Configuration &config )
     }
 
     _routers[node] = Router::NewRouter( config, this, router_name.str( ), 
-					node, 2*_n + 1, 2*_n + 1 );
+					node, 2*_n + _nic, 2*_n + _nic );
     _timed_modules.push_back(_routers[node]);
 
     router_name.str("");
@@ -117,6 +123,9 @@ void KNCube::_BuildNet( const Configuration &config )
 
       // torus channel is longer due to wrap around
       int latency = _mesh ? 1 : 2 ;
+      if ( channel_latency > 0 ) {
+	latency = channel_latency;
+      }
 
       //get the input channel number
       right_input = _LeftChannel( right_node, dim );
@@ -160,11 +169,14 @@ void KNCube::_BuildNet( const Configuration &config )
 
       }
     }
-    //injection and ejection channel, always 1 latency
-    _routers[node]->AddInputChannel( _inject[node], _inject_cred[node] );
-    _routers[node]->AddOutputChannel( _eject[node], _eject_cred[node] );
-    _inject[node]->SetLatency( 1 );
-    _eject[node]->SetLatency( 1 );
+    //injection and ejection channels, 1 latency unless nic_latency is set
+    for ( int cnt = 0; cnt < _nic; ++cnt ) {
+      int c = _nic * node + cnt;
+      _routers[node]->AddInputChannel( _inject[c], _inject_cred[c] );
+      _routers[node]->AddOutputChannel( _eject[c], _eject_cred[c] );
+      _inject[c]->SetLatency( nic_latency );
+      _eject[c]->SetLatency( nic_latency );
+    }
   }
 }
 
@@ -243,7 +255,7 @@ void KNCube::InsertRandomFaults( const Configuration &config )
     } else {
       fail_seed = config.GetInt( "fail_seed" );
     }
-    RandomSeed( fail_seed );
+    RandomFaultScope faults( fail_seed );
 
     vector<bool> fail_nodes(_size);
     //vector<bool> edge_nodes(_size);
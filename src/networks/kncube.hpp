@@ -36,6 +36,7 @@ class KNCube : public Network {
 
   int _k;
   int _n;
+  int _nic;
 
   void _ComputeSize( const Configuration &config );
   void _BuildNet( const Configuration &config );
@@ -37,6 +37,7 @@
 
 #include "booksim.hpp"
 #include "network.hpp"
+#include "random_utils.hpp"
 
 #include "kncube.hpp"
 #include "hcube.hpp"
@@ -58,10 +59,22 @@ Network::Network( const Configuration &config, const string & name ) :
   _nodes    = -1; 
   _channels = -1;
   _classes  = config.GetInt("classes");
+  _channel_modules = 0;
+  _pool     = NULL;
+  _awake    = NULL;
+  _awake_size = 0;
+
+  int const threads = config.GetInt("threads");
+  if ( threads < 1 ) {
+    Error( "threads must be at least 1." );
+  }
+  _threads = threads;
 }
 
 Network::~Network( )
 {
+  delete _pool;
+  delete [] _awake;
   for ( int r = 0; r < _size; ++r ) {
     if ( _routers[r] ) delete _routers[r];
   }
@@ -152,12 +165,12 @@ void Network::_Alloc( )
   for ( int s = 0; s < _nodes; ++s ) {
     ostringstream name;
     name << Name() << "_fchan_ingress" << s;
-    _inject[s] = new FlitChannel(this, name.str(), _classes);
+    _inject[s] = new FlitChannel(this, name.str(), _classes, &_channel_bank);
     _inject[s]->SetSource(NULL, s);
     _timed_modules.push_back(_inject[s]);
     name.str("");
     name << Name() << "_cchan_ingress" << s;
-    _inject_cred[s] = new CreditChannel(this, name.str());
+    _inject_cred[s] = new CreditChannel(this, name.str(), &_channel_bank);
     _timed_modules.push_back(_inject_cred[s]);
   }
   _eject.resize(_nodes);
@@ -165,12 +178,12 @@ void Network::_Alloc( )
   for ( int d = 0; d < _nodes; ++d ) {
     ostringstream name;
     name << Name() << "_fchan_egress" << d;
-    _eject[d] = new FlitChannel(this, name.str(), _classes);
+    _eject[d] = new FlitChannel(this, name.str(), _classes, &_channel_bank);
     _eject[d]->SetSink(NULL, d);
     _timed_modules.push_back(_eject[d]);
     name.str("");
     name << Name() << "_cchan_egress" << d;
-    _eject_cred[d] = new CreditChannel(this, name.str());
+    _eject_cred[d] = new CreditChannel(this, name.str(), &_channel_bank);
     _timed_modules.push_back(_eject_cred[d]);
   }
   _chan.resize(_channels);
@@ -178,43 +191,125 @@ void Network::_Alloc( )
   for ( int c = 0; c < _channels; ++c ) {
     ostringstream name;
     name << Name() << "_fchan_" << c;
-    _chan[c] = new FlitChannel(this, name.str(), _classes);
+    _chan[c] = new FlitChannel(this, name.str(), _classes, &_channel_bank);
     _timed_modules.push_back(_chan[c]);
     name.str("");
     name << Name() << "_cchan_" << c;
-    _chan_cred[c] = new CreditChannel(this, name.str());
+    _chan_cred[c] = new CreditChannel(this, name.str(), &_channel_bank);
     _timed_modules.push_back(_chan_cred[c]);
   }
+  _channel_modules = _timed_modules.size();
 }
 
-void Network::ReadInputs( )
+/* modules are only evaluated while their activity flag is set. A channel
+ * is woken when something is sent on it and wakes its receiving router while
+ * its output is pending; both go back to sleep at the end of WriteOutputs
+ * once IsIdle() reports that nothing is left in flight inside them.
+ */
+void Network::_InitActivity( )
 {
-	int cnt=0;
-  for(deque<TimedModule *>::const_iterator iter = _timed_modules.begin();
-      iter != _timed_modules.end();
-      ++iter) {
-cnt++; 
-//cout << "      network ReadInputs() " << (*iter)->FullName() << "  Module type: " << typeid(**iter).name() << " #" << cnt << endl;
-    (*iter)->ReadInputs( );
+  if ( _awake_size != _timed_modules.size( ) ) {
+    delete [] _awake;
+    _awake_size = _timed_modules.size( );
+    _awake = new atomic<unsigned char>[_awake_size];
+    for ( size_t m = 0; m < _awake_size; ++m ) {
+      _awake[m].store( 1, memory_order_relaxed );
+      _timed_modules[m]->SetActivityFlag( &_awake[m] );
+    }
   }
 }
 
-void Network::Evaluate( )
+void Network::_RunPhase( void (TimedModule::*phase)( ), int begin, int end )
+{
+  bool const sleep = ( phase == &TimedModule::WriteOutputs );
+  RandomStream * const stream = gRandomStream;
+  for ( int m = begin; m < end; ++m ) {
+    if ( !_awake[m].load( memory_order_relaxed ) ) {
+      continue;
+    }
+    TimedModule * const module = _timed_modules[m];
+    // every router draws from its own stream, whichever thread runs it
+    if ( gRandomStreams ) {
+      gRandomStream = module->GetRandomStream( );
+    }
+    (module->*phase)( );
+    if ( sleep && module->IsIdle( ) ) {
+      _awake[m].store( 0, memory_order_relaxed );
+    }
+  }
+  gRandomStream = stream;
+}
+
+/* the channels are run from the bank, which moves plain data through them
+ * without calling each one; Evaluate does nothing in a channel
+ */
+void Network::_RunChannels( void (TimedModule::*phase)( ), int begin, int end )
+{
+  if ( phase == &TimedModule::ReadInputs ) {
+    _channel_bank.ReadInputs( begin, end, _awake );
+  } else if ( phase == &TimedModule::WriteOutputs ) {
+    _channel_bank.WriteOutputs( begin, end, _awake );
+  }
+}
+
+/* with threads > 1 each phase first runs all channels and then all routers,
+ * both split across the thread pool. Within a phase a channel only touches
+ * its own state and a router only its own state, its own routing table rows
+ * and the send side of its output channels, so the result does not depend on
+ * the order the modules are visited in and matches the serial run. Channels
+ * only wake routers and routers only wake channels, so the activity flags a
+ * pass reads are never written during that pass.
+ */
+void Network::_Phase( void (TimedModule::*phase)( ) )
 {
-  for(deque<TimedModule *>::const_iterator iter = _timed_modules.begin();
-      iter != _timed_modules.end();
-      ++iter) {
-    (*iter)->Evaluate( );
+  _InitActivity( );
+  if ( _threads == 1 ) {
+    _RunChannels( phase, 0, _channel_modules );
+    _RunPhase( phase, _channel_modules, (int)_awake_size );
+    return;
+  }
+  // the workers start with the first cycle, so that a built network can be
+  // handed to a forked process (see sweep.cpp)
+  if ( !_pool ) {
+    _pool = new ThreadPool( _threads );
   }
+  ThreadPool::tRangeTask const channels = [this, phase](int begin, int end) {
+    _RunChannels( phase, begin, end );
+  };
+  _pool->Run( _channel_modules, channels );
+  int const offset = _channel_modules;
+  ThreadPool::tRangeTask const routers = [this, phase, offset](int begin, int end) {
+    _RunPhase( phase, offset + begin, offset + end );
+  };
+  _pool->Run( (int)_awake_size - _channel_modules, routers );
+}
+
+void Network::ReadInputs( )
+{
+  _Phase( &TimedModule::ReadInputs );
+}
+
+void Network::Evaluate( )
+{
+  _Phase( &TimedModule::Evaluate );
 }
 
 void Network::WriteOutputs( )
 {
-  for(deque<TimedModule *>::const_iterator iter = _timed_modules.begin();
-      iter != _timed_modules.end();
-      ++iter) {
-    (*iter)->WriteOutputs( );
+  _Phase( &TimedModule::WriteOutputs );
+}
+
+bool Network::IsIdle( ) const
+{
+  if ( _awake_size != _timed_modules.size( ) ) {
+    return false;
+  }
+  for ( size_t m = 0; m < _awake_size; ++m ) {
+    if ( _awake[m].load( memory_order_relaxed ) ) {
+      return false;
+    }
   }
+  return true;
 }
 
 void Network::WriteFlit( Flit *f, int source )
@@ -39,8 +39,10 @@
 #include "timed_module.hpp"
 #include "flitchannel.hpp"
 #include "channel.hpp"
+#include "channel_bank.hpp"
 #include "config_utils.hpp"
 #include "globals.hpp"
+#include "thread_pool.hpp"
 
 typedef Channel<Credit> CreditChannel;
 
@@ -65,11 +67,26 @@ protected:
   vector<CreditChannel *> _chan_cred;
 
   deque<TimedModule *> _timed_modules;
+  // _timed_modules starts with the channels allocated by _Alloc, in the
+  // order of their entries in _channel_bank
+  int _channel_modules;
+  ChannelBank _channel_bank;
+
+  int _threads;
+  ThreadPool * _pool;
+
+  // one activity flag per entry of _timed_modules
+  atomic<unsigned char> * _awake;
+  size_t _awake_size;
 
   virtual void _ComputeSize( const Configuration &config ) = 0;
   virtual void _BuildNet( const Configuration &config ) = 0;
 
   void _Alloc( );
+  void _InitActivity( );
+  void _RunPhase( void (TimedModule::*phase)( ), int begin, int end );
+  void _RunChannels( void (TimedModule::*phase)( ), int begin, int end );
+  void _Phase( void (TimedModule::*phase)( ) );
 
 public:
   Network( const Configuration &config, const string & name );
@@ -94,6 +111,9 @@ public:
   virtual void Evaluate( );
   virtual void WriteOutputs( );
 
+  // true once every channel and router has gone to sleep
+  virtual bool IsIdle( ) const;
+
   void Display( ostream & os = cout ) const;
   void DumpChannelMap( ostream & os = cout, string const & prefix = "" ) const;
   void DumpNodeMap( ostream & os = cout, string const & prefix = "" ) const;
@@ -34,15 +34,13 @@
 #include "random_utils.hpp"
 #include "misc_utils.hpp"
 #include "globals.hpp"
+#include "collective.hpp"
 #include "polarfly_tables.hpp"
+#include "polarfly_route_table.hpp"
 
-#define POLAR_LATENCY 
-#define Polarflysize POLARFLY_TABLE_ROWS
+#define Polarflysize polarfly_table_rows
 
 int gP_polar, gA_polar, gG_polar;
-bool fault_table[total_node][node_port] = {false};
-bool fault_nodes[total_node] = {false};
-
 
 //Hypercube : Local (group)
 //Polarfly  : Global
@@ -117,6 +115,28 @@ PolarFlyplusNew::PolarFlyplusNew( const Configuration &config, const string & na
   _ComputeSize( config );
   _Alloc( );
   _BuildNet( config );
+
+  // the table belongs to the most recently built network
+  delete gPolarFlyRouteTable;
+  gPolarFlyRouteTable = NULL;
+
+  string const route_table = config.GetStr( "pfp_route_table" );
+  if ( route_table != "none" ) {
+    if ( ( route_table != "group" ) && ( route_table != "full" ) ) {
+      Error( "Unknown pfp_route_table: " + route_table );
+    }
+    gPolarFlyRouteTable = new PolarFlyRouteTable( _size, Polarflysize, PolarFlyPlusHypercubePorts( config ),
+						  route_table == "group",
+						  &polarflyplus_source_route );
+    gPolarFlyRouteTable->Build( );
+  }
+}
+
+PolarFlyplusNew::~PolarFlyplusNew( )
+{
+  // the routes were built for this network and are no longer valid
+  delete gPolarFlyRouteTable;
+  gPolarFlyRouteTable = NULL;
 }
 
 void PolarFlyplusNew::_ComputeSize( const Configuration &config )
@@ -125,20 +145,19 @@ void PolarFlyplusNew::_ComputeSize( const Configuration &config )
   // LIMITATION
   // _n == # of dimensions within a group
   // _p == # of processors within a router
-  //_p = config.GetInt( "k" );// # of nodes in each switch=1
-  //_n = config.GetInt( "n" );
-  int Hypercubeport = config.GetInt( "k" );
-  int Polarflyport = config.GetInt( "n" );
+  _p = config.GetInt( "nic" );// # of nodes in each switch
+  _n = 1;
+  int Hypercubeport = PolarFlyPlusHypercubePorts( config );
+  int Polarflyport = PolarFlyPlusPolarFlyPorts( config );
 
-  _p=1;
-  _n=1;
-  assert(_n==1);
 
-  _k = Polarflyport + Hypercubeport + 1; // Polarfly + Hyoercube+  CPU  
+  _k = Polarflyport + Hypercubeport + _p; // Polarfly + Hyoercube+  CPU  
 
   // FIX...
   gK = _p; gN = _n;
 
+  InitializePolarFlyTable( config, Polarflyport );
+
   //group : Hypercube
   _a = powi(2,Hypercubeport);
   _g = Polarflysize; 
@@ -147,6 +166,7 @@ void PolarFlyplusNew::_ComputeSize( const Configuration &config )
   _num_of_switch = _nodes / _p;
   _channels = _num_of_switch * (Polarflyport + Hypercubeport); 
   _size = _num_of_switch;
+  ResizePolarFlyTables( _size, _k );
   
   gG_polar = _g;
   gP_polar = _p;
@@ -161,15 +181,18 @@ void PolarFlyplusNew::_BuildNet( const Configuration &config )
 
   int _output=-1;
   int _input=-1;
-  //int _dim_ID=-1;
-  //int _num_ports_per_switch=Polarflyport+Hypercubeport+1;
   int c;
-  int Hypercubeport = config.GetInt( "k" );
-  int Polarflyport = config.GetInt( "n" );
+  int Hypercubeport = PolarFlyPlusHypercubePorts( config );
+  int Polarflyport = PolarFlyPlusPolarFlyPorts( config );
   ostringstream router_name;
 
+  // NIC 200ns + MPI overhead + calculation 100ns per side with nic_latency
+  int const nic_latency = config.GetInt( "nic_latency" );
+  // XB (20ns) + TX_TD + 5m + RX_TD with channel_latency
+  int const channel_latency = config.GetInt( "channel_latency" ) > 0 ? config.GetInt( "channel_latency" ) : 1;
+
   cout << " Polarflyplus " << endl;
-  cout << " p = " << _p << " n = " << _n << endl;
+  cout << " p = " << _p << " hypercubeport = " << Hypercubeport << " PolarFlyport = " << Polarflyport << endl;
   cout << " each switch - total radix =  "<< _k << endl;
   cout << " # of switches = "<<  _num_of_switch << endl;
   cout << " # of channels = "<<  _channels << endl;
@@ -197,15 +220,21 @@ void PolarFlyplusNew::_BuildNet( const Configuration &config )
     for ( int cnt = 0; cnt < _p; ++cnt ) {
       c = _p * node +  cnt;
       _routers[node]->AddInputChannel( _inject[c], _inject_cred[c] );
+      if ( nic_latency > 0 ) {
+        _inject[c]->SetLatency(nic_latency);
+        _inject_cred[c]->SetLatency(nic_latency);
+      }
     }
 
     for ( int cnt = 0; cnt < _p; ++cnt ) {
       c = _p * node +  cnt;
       _routers[node]->AddOutputChannel( _eject[c], _eject_cred[c] );
+      if ( nic_latency > 0 ) {
+        _eject[c]->SetLatency(nic_latency);
+        _eject_cred[c]->SetLatency(nic_latency);
+      }
     }
 
-    if (_n > 1 )  { cout << " ERROR: n>1 dimension NOT supported yet... " << endl; exit(-1); }
-
     //********************************************
     //   connect OUTPUT channels
     //********************************************
@@ -218,22 +247,16 @@ void PolarFlyplusNew::_BuildNet( const Configuration &config )
         dbg.push_back({ to_string(_output), "Hypercube","node"+to_string(node)+"-port"+to_string(cnt) });
 	_routers[node]->AddOutputChannel( _chan[_output], _chan_cred[_output] );
 
-#ifdef POLAR_LATENCY
-	_chan[_output]->SetLatency(1);
-	_chan_cred[_output]->SetLatency(1);
-#endif
+	_chan[_output]->SetLatency(channel_latency);
+	_chan_cred[_output]->SetLatency(channel_latency);
       }
     //add polarfly output channel
     for ( int cnt = 0; cnt < Polarflyport; ++cnt ) {
       _output = (Polarflyport+Hypercubeport) * node + Hypercubeport + cnt;
-      //_chan[_output].global = true;
-      //if(grp_ID < Polarflyport  && cnt==Polarflyport-1) continue; //red group : no self-connection
       dbg.push_back({ to_string(_output), "Polarfly","node"+to_string(node)+"-port"+to_string(cnt+Hypercubeport) });
       _routers[node]->AddOutputChannel( _chan[_output], _chan_cred[_output] );
-#ifdef POLAR_LATENCY
-      _chan[_output]->SetLatency(1);
-      _chan_cred[_output]->SetLatency(1);
-#endif
+      _chan[_output]->SetLatency(channel_latency);
+      _chan_cred[_output]->SetLatency(channel_latency);
     }
 
     //********************************************
@@ -249,20 +272,20 @@ void PolarFlyplusNew::_BuildNet( const Configuration &config )
        ch_count++;
 	_routers[node]->AddInputChannel( _chan[_input], _chan_cred[_input] );
       }
-    //Polarfly  table refer
-    int dest_polarport;
+    //Polarfly table refer
     for ( int cnt = 0; cnt < Polarflyport; ++cnt ) {
-      for(int i = 0 ; i < 8; i++){
+      // _CheckTable guarantees the reverse edge
+      int dest_polarport=-1;
+      for(int i = 0 ; i < Polarflyport; i++){
           if (polarfly_connection_table[polarfly_connection_table[grp_ID][cnt]][i]==grp_ID){
                 dest_polarport=i+Hypercubeport;
 		break;
 	  }
       }
+      assert(dest_polarport >= 0);
       int hyperadd = node%(powi(2,Hypercubeport));
       int dest_node_add = polarfly_connection_table[grp_ID][cnt]*powi(2,Hypercubeport)+hyperadd;
-      //cout << hyperadd << " " << polarfly_connection_table[grp_ID][cnt] << endl; 
       _input = dest_node_add * (Polarflyport+Hypercubeport) + dest_polarport;
-      //if(grp_ID < Polarflyport && cnt== Polarflyport-1) continue; //red group : no self-connection
        dbg[ch_count].push_back (to_string(_input)+" node"+to_string(dest_node_add)+"-port"+to_string(dest_polarport));
        ch_count++;
       _routers[node]->AddInputChannel( _chan[_input], _chan_cred[_input] );
@@ -282,8 +305,8 @@ void PolarFlyplusNew::_BuildNet( const Configuration &config )
 void PolarFlyplusNew::InsertRandomFaults( const Configuration &config )
 {
   int num_fails = config.GetInt( "link_failures" );
-  int Hypercubeport = config.GetInt( "k" );
-  int Polarflyport = config.GetInt( "n" );
+  int Hypercubeport = PolarFlyPlusHypercubePorts( config );
+  int Polarflyport = PolarFlyPlusPolarFlyPorts( config );
   if ( _size && num_fails ) {
     vector<long> save_x;
     vector<double> save_u;
@@ -295,28 +318,22 @@ void PolarFlyplusNew::InsertRandomFaults( const Configuration &config )
     } else {
       fail_seed = config.GetInt( "fail_seed" );
     }
-    RandomSeed( fail_seed );
+    RandomFaultScope faults( fail_seed );
 
     vector<bool> fail_nodes(_size);
-    /*
-    for ( int i = 0; i < num_fails; i++ ) {
-      int node = RandomInt( _size - 1 );
-      int chan = RandomInt( _size * ( Hypercubeport + Polarflyport ) ) % ( Hypercubeport + Polarflyport ) + 1;
-      OutChannelFault( node, chan );
-      fault_table[node][chan]=true;
-      cout << "failure at node" << node << " out_port" << chan << endl;
-    }
-    */
     
     for ( int i = 0; i < num_fails; i++ ) {
       int failnode = RandomInt( _size - 1 );
       fault_nodes[failnode] = true;
+      for(int j = 0 ; j < _k ; j++){
+         fault_table[failnode][j]=true;
+      }
       for(int j = 0; j <  Hypercubeport + Polarflyport ; j++){
          int pairnode=-1;
 	 int pairport=-1;
      	 if(j < Hypercubeport){
 	   pairnode = failnode ^ (1<<j);
-	   pairport = j+1;
+	   pairport = j+_p;
 	 }
 	 else{
            int failgrp = failnode >> Hypercubeport;
@@ -324,7 +341,7 @@ void PolarFlyplusNew::InsertRandomFaults( const Configuration &config )
            pairnode = pairgrp*(1<<Hypercubeport) + (failnode % (1<<Hypercubeport));
 	   for(int k = 0 ; k < Polarflyport; k++){
 	      if(polarfly_connection_table[pairgrp][k]==failgrp){
-	          pairport=Hypercubeport+k+1;
+	          pairport=Hypercubeport+k+_p;
 		  //break;
 	      }
 	   } 
@@ -336,6 +353,9 @@ void PolarFlyplusNew::InsertRandomFaults( const Configuration &config )
     }
     
     RestoreRandomState( save_x, save_u );
+    if ( gPolarFlyRouteTable ) {
+      gPolarFlyRouteTable->Build( );
+    }
   }
 #ifdef PFP_FAULT_DEBUG
   for(int i = 0 ; i < Polarflysize*(1<<Hypercubeport); i++){
@@ -350,10 +370,9 @@ void PolarFlyplusNew::InsertRandomFaults( const Configuration &config )
         if(!fault_table[i][j]){cout << "O";}
         else {cout << "X";}
       }cout << endl;
-   }
+  }
 #endif
 }
-
 double PolarFlyplusNew::Capacity( ) const
 {
   return (double)_k / 8.0;
@@ -55,6 +55,7 @@ class PolarFlyplusNew : public Network {
  
 public:
   PolarFlyplusNew( const Configuration &config, const string & name );
+  ~PolarFlyplusNew( );
 
   int GetN( ) const;
   int GetK( ) const;
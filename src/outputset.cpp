@@ -38,9 +38,37 @@
 #include "booksim.hpp"
 #include "outputset.hpp"
 
+OutputSet::OutputSet( OutputSet const & other )
+  : _size( 0 ), _overflow( 0 )
+{
+  *this = other;
+}
+
+OutputSet & OutputSet::operator=( OutputSet const & other )
+{
+  if ( this == &other ) {
+    return *this;
+  }
+  if ( other._size > kInline ) {
+    if ( !_overflow ) {
+      _overflow = new vector<sSetElement>;
+    }
+    *_overflow = *other._overflow;
+  } else {
+    for ( int i = 0; i < other._size; ++i ) {
+      _inline[i] = other._inline[i];
+    }
+  }
+  _size = other._size;
+  return *this;
+}
+
 void OutputSet::Clear( )
 {
-  _outputs.clear( );
+  _size = 0;
+  if ( _overflow ) {
+    _overflow->clear( );
+  }
 }
 
 void OutputSet::Add( int output_port, int vc, int pri  )
@@ -57,40 +85,52 @@ void OutputSet::AddRange( int output_port, int vc_start, int vc_end, int pri )
   s.vc_end   = vc_end;
   s.pri      = pri;
   s.output_port = output_port;
-  _outputs.insert( s );
+
+  if ( _size == kInline ) {
+    if ( !_overflow ) {
+      _overflow = new vector<sSetElement>;
+    }
+    _overflow->assign( _inline, _inline + kInline );
+  }
+  sSetElement * data;
+  if ( _size >= kInline ) {
+    _overflow->push_back( s );
+    data = &( *_overflow )[0];
+  } else {
+    data = _inline;
+  }
+  // behind every candidate of the same or a higher priority
+  int i = _size;
+  while ( ( i > 0 ) && ( data[i-1].pri < pri ) ) {
+    data[i] = data[i-1];
+    --i;
+  }
+  data[i] = s;
+  ++_size;
 }
 
 //legacy support, for performance, just use GetSet()
 int OutputSet::NumVCs( int output_port ) const
 {
   int total = 0;
-  set<sSetElement>::const_iterator i = _outputs.begin( );
-  while(i!=_outputs.end( )){
+  for ( const_iterator i = begin( ); i != end( ); ++i ) {
     if(i->output_port == output_port){
       total += (i->vc_end - i->vc_start + 1);
     }
-    i++;
   }
   return total;
 }
 
 bool OutputSet::OutputEmpty( int output_port ) const
 {
-  set<sSetElement>::const_iterator i = _outputs.begin( );
-  while(i!=_outputs.end( )){
+  for ( const_iterator i = begin( ); i != end( ); ++i ) {
     if(i->output_port == output_port){
       return false;
     }
-    i++;
   }
   return true;
 }
 
-
-const set<OutputSet::sSetElement> & OutputSet::GetSet() const{
-  return _outputs;
-}
-
 //legacy support, for performance, just use GetSet()
 int OutputSet::GetVC( int output_port, int vc_index, int *pri ) const
 {
@@ -101,8 +141,7 @@ int OutputSet::GetVC( int output_port, int vc_index, int *pri ) const
   
   if ( pri ) { *pri = -1; }
 
-  set<sSetElement>::const_iterator i = _outputs.begin( );
-  while(i!=_outputs.end( )){
+  for ( const_iterator i = begin( ); i != end( ); ++i ) {
     if(i->output_port == output_port){
       range = i->vc_end - i->vc_start + 1;
       if ( remaining >= range ) {
@@ -115,7 +154,6 @@ int OutputSet::GetVC( int output_port, int vc_index, int *pri ) const
 	break;
       }
     }
-    i++;
   }
   return vc;
 }
@@ -128,11 +166,11 @@ bool OutputSet::GetPortVC( int *out_port, int *out_vc ) const
   bool single_output = false;
   int  used_outputs  = 0;
 
-  set<sSetElement>::const_iterator i = _outputs.begin( );
-  if(i!=_outputs.end( )){
+  const_iterator i = begin( );
+  if(i!=end( )){
     used_outputs = i->output_port;
   }
-  while(i!=_outputs.end( )){
+  while(i!=end( )){
 
     if ( i->vc_start == i->vc_end ) {
       *out_vc   = i->vc_start;
@@ -28,8 +28,13 @@
 #ifndef _OUTPUTSET_HPP_
 #define _OUTPUTSET_HPP_
 
-#include <set>
+#include <vector>
 
+using namespace std;
+
+// The route candidates of a flit, highest priority first and candidates of
+// equal priority in the order they were added. Up to kInline candidates are
+// kept inside the object, so a routing function call does not allocate.
 class OutputSet {
 
 
@@ -40,6 +45,12 @@ public:
     int pri;
     int output_port;
   };
+  typedef sSetElement const * const_iterator;
+
+  OutputSet( ) : _size( 0 ), _overflow( 0 ) { }
+  OutputSet( OutputSet const & other );
+  OutputSet & operator=( OutputSet const & other );
+  ~OutputSet( ) { delete _overflow; }
 
   void Clear( );
   void Add( int output_port, int vc, int pri = 0 );
@@ -48,19 +59,27 @@ public:
   bool OutputEmpty( int output_port ) const;
   int NumVCs( int output_port ) const;
   
-  const set<sSetElement> & GetSet() const;
+  // the candidates are iterated over through the set itself
+  inline OutputSet const & GetSet( ) const { return *this; }
+  inline const_iterator begin( ) const { return _Data( ); }
+  inline const_iterator end( ) const { return _Data( ) + _size; }
+  inline bool empty( ) const { return _size == 0; }
+  inline size_t size( ) const { return _size; }
 
   int  GetVC( int output_port,  int vc_index, int *pri = 0 ) const;
   bool GetPortVC( int *out_port, int *out_vc ) const;
 private:
-  set<sSetElement> _outputs;
-};
+  static int const kInline = 4;
 
-inline bool operator<(const OutputSet::sSetElement & se1, 
-	       const OutputSet::sSetElement & se2) {
-  return se1.pri > se2.pri; // higher priorities first!
-}
-
-#endif
+  int _size;
+  sSetElement _inline[kInline];
+  // holds all candidates while there are more than kInline; kept across
+  // Clear() so that it is only allocated once
+  vector<sSetElement> * _overflow;
 
+  inline sSetElement const * _Data( ) const {
+    return ( _size > kInline ) ? &( *_overflow )[0] : _inline;
+  }
+};
 
+#endif
@@ -0,0 +1,167 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+#include <cassert>
+
+#include "polarfly_route_table.hpp"
+#include "polarfly_tables.hpp"
+
+PolarFlyRouteTable * gPolarFlyRouteTable = NULL;
+
+PolarFlyRouteTable::PolarFlyRouteTable( int routers, int groups, int dim,
+					bool group_relative,
+					tSourceRouteFunction compute )
+  : _routers(routers), _groups(groups), _dim(dim),
+    _group_relative(group_relative), _compute(compute)
+{
+  assert(_routers == (_groups << _dim));
+  assert(_compute);
+}
+
+PolarFlyRoute PolarFlyRouteTable::Pack( int local_move1, int local_move2, int local_move3,
+					int global_port1, int global_port2 )
+{
+  assert((local_move1 >= 0) && (local_move1 <= 0xff));
+  assert((local_move2 >= 0) && (local_move2 <= 0xff));
+  assert((local_move3 >= 0) && (local_move3 <= 0xff));
+  assert((global_port1 >= 0) && (global_port1 <= 0xff));
+  assert((global_port2 >= 0) && (global_port2 <= 0xff));
+  PolarFlyRoute route;
+  route.local_move[0] = local_move1;
+  route.local_move[1] = local_move2;
+  route.local_move[2] = local_move3;
+  route.global_port[0] = global_port1;
+  route.global_port[1] = global_port2;
+  return route;
+}
+
+// A route only visits its source group, its destination group and a group
+// adjacent to both, so it is unaffected by faults if all of them are clean.
+void PolarFlyRouteTable::_MarkFaultyGroups( )
+{
+  vector<bool> faulty(_groups, false);
+  for ( int r = 0; r < _routers; ++r ) {
+    for ( int p = 0; p < node_port; ++p ) {
+      if ( fault_table[r][p] ) {
+	faulty[r >> _dim] = true;
+	break;
+      }
+    }
+  }
+
+  _clean.assign(_groups * _groups, true);
+  for ( int sg = 0; sg < _groups; ++sg ) {
+    for ( int dg = 0; dg < _groups; ++dg ) {
+      bool clean = !faulty[sg] && !faulty[dg];
+      for ( int i = 0; clean && ( i < polarfly_table_cols ); ++i ) {
+	int const g = polarfly_connection_table[sg][i];
+	for ( int j = 0; j < polarfly_table_cols; ++j ) {
+	  if ( ( polarfly_connection_table[dg][j] == g ) && faulty[g] ) {
+	    clean = false;
+	    break;
+	  }
+	}
+      }
+      _clean[sg * _groups + dg] = clean;
+    }
+  }
+}
+
+void PolarFlyRouteTable::Build( )
+{
+  _MarkFaultyGroups( );
+  _faulty.clear( );
+
+  // group-relative entries are computed without faults and stay valid
+  if ( _group.empty() ) {
+    _group.resize(_groups * _groups * (1 << _dim) * 2);
+    vector<atomic<bool> >(_group.size()).swap(_group_valid);
+  }
+
+  if ( _group_relative ) {
+    _full.clear( );
+    return;
+  }
+
+  _full.resize((size_t)_routers * _routers * 2);
+  for ( int src = 0; src < _routers; ++src ) {
+    for ( int dest = 0; dest < _routers; ++dest ) {
+      for ( int c = 0; c < 2; ++c ) {
+	size_t const index = ((size_t)src * _routers + dest) * 2 + c;
+	if ( _clean[(src >> _dim) * _groups + (dest >> _dim)] ) {
+	  _full[index] = _GroupEntry(src, dest, c);
+	} else {
+	  _full[index] = _compute(src, dest, c, true);
+	}
+      }
+    }
+  }
+}
+
+PolarFlyRoute const & PolarFlyRouteTable::_GroupEntry( int src, int dest, int vc_class )
+{
+  int const offsets = 1 << _dim;
+  int const sg = src >> _dim;
+  int const dg = dest >> _dim;
+  int const offset = (src ^ dest) & (offsets - 1);
+  size_t const index = (((size_t)sg * _groups + dg) * offsets + offset) * 2 + vc_class;
+  if ( !_group_valid[index].load(memory_order_acquire) ) {
+    PolarFlyRoute const route = _compute(sg << _dim, (dg << _dim) | offset, vc_class, false);
+    lock_guard<mutex> lock(_fill);
+    if ( !_group_valid[index].load(memory_order_relaxed) ) {
+      _group[index] = route;
+      _group_valid[index].store(true, memory_order_release);
+    }
+  }
+  return _group[index];
+}
+
+PolarFlyRoute const & PolarFlyRouteTable::Lookup( int src, int dest, int vc_class )
+{
+  assert((src >= 0) && (src < _routers));
+  assert((dest >= 0) && (dest < _routers));
+  assert((vc_class == 0) || (vc_class == 1));
+
+  if ( !_group_relative ) {
+    return _full[((size_t)src * _routers + dest) * 2 + vc_class];
+  }
+  if ( _clean[(src >> _dim) * _groups + (dest >> _dim)] ) {
+    return _GroupEntry(src, dest, vc_class);
+  }
+  long long const key = ((long long)src * _routers + dest) * 2 + vc_class;
+  {
+    lock_guard<mutex> lock(_fill);
+    map<long long, PolarFlyRoute>::const_iterator iter = _faulty.find(key);
+    if ( iter != _faulty.end() ) {
+      return iter->second;
+    }
+  }
+  PolarFlyRoute const route = _compute(src, dest, vc_class, true);
+  lock_guard<mutex> lock(_fill);
+  return _faulty.insert(make_pair(key, route)).first->second;
+}
@@ -0,0 +1,97 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*polarfly_route_table.hpp
+ *
+ *Precomputed PolarFly+ source routes. The route of a packet only depends on
+ *its source router, its destination router and its VC class (request or
+ *reply), so the table is built once when the network is constructed and the
+ *injection router only has to look the route up.
+ *
+ *In group-relative mode only one entry per (source group, destination group,
+ *hypercube offset, VC class) is kept: without faults the hypercube part is
+ *symmetric under XOR. Entries are filled in on first use. Pairs whose route
+ *may touch a faulty router are computed with the fault table and cached
+ *separately. Lookup() may be called by several router threads at once.
+ *
+ */
+
+#ifndef _POLARFLY_ROUTE_TABLE_HPP_
+#define _POLARFLY_ROUTE_TABLE_HPP_
+
+#include <vector>
+#include <map>
+#include <atomic>
+#include <mutex>
+
+#include "flit.hpp"
+
+using namespace std;
+
+typedef PolarFlyRoute (*tSourceRouteFunction)( int src, int dest, int vc_class, bool use_faults );
+
+class PolarFlyRouteTable {
+
+  int _routers;
+  int _groups;
+  int _dim;
+  bool _group_relative;
+  tSourceRouteFunction _compute;
+
+  // dense [src][dest][class] table (full mode)
+  vector<PolarFlyRoute> _full;
+  // [src_grp][dest_grp][offset][class] table (group-relative mode)
+  vector<PolarFlyRoute> _group;
+  vector<atomic<bool> > _group_valid;
+  // pairs of groups whose routes cannot be affected by a fault
+  vector<bool> _clean;
+  // routes of router pairs that touch a faulty group
+  map<long long, PolarFlyRoute> _faulty;
+  // guards filling in _group and _faulty
+  mutex _fill;
+
+  void _MarkFaultyGroups( );
+  PolarFlyRoute const & _GroupEntry( int src, int dest, int vc_class );
+
+public:
+  PolarFlyRouteTable( int routers, int groups, int dim, bool group_relative,
+		      tSourceRouteFunction compute );
+
+  void Build( );
+
+  PolarFlyRoute const & Lookup( int src, int dest, int vc_class );
+
+  static PolarFlyRoute Pack( int local_move1, int local_move2, int local_move3,
+			     int global_port1, int global_port2 );
+};
+
+extern PolarFlyRouteTable * gPolarFlyRouteTable;
+
+// source route computation in routefunc.cpp
+PolarFlyRoute polarflyplus_source_route( int src, int dest, int vc_class, bool use_faults );
+
+#endif
@@ -0,0 +1,449 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*polarfly_tables.cpp
+ *
+ *PolarFly incidence table and the per-router tables sized from it. The
+ *incidence table is either one of the built-in tables, the Erdos-Renyi
+ *polarity graph ER_q generated for q = polarfly ports - 1, or read from a
+ *file (polarfly_table = <file>).
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+
+#include "polarfly_tables.hpp"
+#include "collective.hpp"
+
+vector<vector<int> > polarfly_connection_table;
+int polarfly_table_rows = 0;
+int polarfly_table_cols = 0;
+int total_node = 0;
+int node_port = 0;
+vector<vector<bool> > fault_table;
+vector<bool> fault_nodes;
+vector<vector<int> > traffic_table;
+vector<vector<int> > step_table;
+vector<int> delay_table;
+vector<int> cycle_table;
+
+// built-in tables; quadric groups come first and list themselves last
+static const int polarfly_table_1x1[1][1] = {
+    {0}
+};
+
+static const int polarfly_table_7x3[7][3] = {
+    {3,4,0},
+    {5,4,1},
+    {6,4,2},
+    {6,5,0},
+    {0,1,2},
+    {6,3,1},
+    {5,3,2}
+};
+
+static const int polarfly_table_13x4[13][4] = {
+    {4,5,6,0},
+    {7,8,6,1},
+    {7,5,9,2},
+    {4,8,9,3},
+    {7,10,0,3},
+    {11,8,0,2},
+    {12,9,0,1},
+    {4,10,1,2},
+    {11,5,1,3},
+    {12,6,2,3},
+    {12,11,7,4},
+    {12,10,8,5},
+    {11,10,9,6}
+};
+
+static const int polarfly_table_31x6[31][6] = {
+    {6,7,8,9,10,0},
+    {6,11,12,13,14,1},
+    {15,7,16,17,14,2},
+    {15,11,18,19,10,3},
+    {20,12,16,18,8,4},
+    {20,9,17,19,13,5},
+    {20,15,21,0,1,22},
+    {0,2,23,12,19,24},
+    {0,25,11,4,17,26},
+    {0,27,28,18,5,14},
+    {0,3,29,16,13,30},
+    {1,3,28,8,17,24},
+    {1,27,7,4,19,30},
+    {1,25,23,16,5,10},
+    {1,2,29,18,9,26},
+    {20,6,25,2,3,27},
+    {22,2,28,4,13,10},
+    {21,2,11,8,5,30},
+    {21,3,23,4,9,14},
+    {22,3,7,12,5,26},
+    {15,6,29,4,5,24},
+    {22,6,23,18,17,30},
+    {21,6,28,16,19,26},
+    {21,25,7,18,13,24},
+    {20,29,28,7,11,23},
+    {15,27,23,8,13,26},
+    {22,25,29,8,19,14},
+    {15,25,28,12,9,30},
+    {22,27,11,16,9,24},
+    {20,24,30,14,10,26},
+    {21,27,29,12,17,10}
+};
+
+static const int polarfly_table_57x8[57][8] = {
+    {8,9,10,11,12,13,14,0},
+    {15,16,17,11,18,19,20,1},
+    {21,22,23,24,12,19,25,2},
+    {26,27,28,24,18,13,29,3},
+    {26,22,17,30,31,32,14,4},
+    {21,27,10,33,34,32,20,5},
+    {15,9,23,33,31,35,29,6},
+    {8,16,28,30,34,35,25,7},
+    {26,36,23,0,37,38,7,20},
+    {39,22,40,0,34,18,6,41},
+    {42,43,28,0,31,5,19,44},
+    {45,24,33,46,0,1,47,30},
+    {48,16,49,0,2,50,32,29},
+    {21,51,17,0,3,35,52,53},
+    {15,27,54,0,55,4,56,25},
+    {21,36,28,1,55,50,6,14},
+    {39,27,49,1,31,12,7,53},
+    {48,51,23,1,34,4,13,44},
+    {42,9,40,1,3,38,32,25},
+    {26,43,10,1,2,35,56,41},
+    {8,22,54,1,37,5,52,29},
+    {15,36,40,30,2,5,13,53},
+    {39,9,28,46,2,4,52,20},
+    {8,27,17,47,2,38,6,44},
+    {45,11,37,2,34,31,3,55},
+    {42,51,54,33,2,18,7,14},
+    {8,36,49,33,3,4,19,41},
+    {39,16,23,47,3,5,56,14},
+    {15,22,10,46,3,50,7,44},
+    {48,43,54,30,3,12,6,20},
+    {21,43,40,47,11,4,7,29},
+    {42,16,10,24,37,4,6,53},
+    {45,35,50,4,18,12,5,38},
+    {26,51,49,46,11,5,6,25},
+    {48,9,17,24,55,5,7,41},
+    {45,32,13,52,6,7,56,19},
+    {45,39,42,21,15,8,26,48},
+    {8,51,40,24,31,50,56,20},
+    {8,43,23,46,55,18,32,53},
+    {45,36,43,9,22,27,16,51},
+    {21,9,49,30,37,18,56,44},
+    {26,9,54,47,34,50,19,53},
+    {48,36,10,47,31,18,52,25},
+    {39,51,10,30,55,38,19,29},
+    {45,54,17,28,40,49,23,10},
+    {39,36,54,24,11,35,32,44},
+    {48,22,28,33,11,38,56,53},
+    {42,27,23,30,11,50,52,41},
+    {42,36,17,46,34,12,56,29},
+    {26,16,40,33,55,12,52,44},
+    {15,51,28,47,37,12,32,41},
+    {39,43,17,33,37,50,13,25},
+    {42,22,49,47,55,35,13,20},
+    {21,16,54,46,31,38,13,41},
+    {45,44,25,20,41,53,14,29},
+    {15,43,49,24,34,38,52,14},
+    {48,27,40,46,37,35,19,14}
+};
+
+template<int R, int C>
+static void _LoadPreset( const int (&table)[R][C] )
+{
+  polarfly_connection_table.assign(R, vector<int>(C));
+  for ( int g = 0; g < R; ++g ) {
+    for ( int i = 0; i < C; ++i ) {
+      polarfly_connection_table[g][i] = table[g][i];
+    }
+  }
+}
+
+static bool _LoadPreset( int q )
+{
+  switch ( q ) {
+  case 0: _LoadPreset(polarfly_table_1x1); return true;
+  case 2: _LoadPreset(polarfly_table_7x3); return true;
+  case 3: _LoadPreset(polarfly_table_13x4); return true;
+  case 5: _LoadPreset(polarfly_table_31x6); return true;
+  case 7: _LoadPreset(polarfly_table_57x8); return true;
+  }
+  return false;
+}
+
+// Builds the addition and multiplication tables of GF(q), q = p^m. Elements
+// are polynomials over GF(p) stored as base-p digits; the reduction
+// polynomial is the first monic degree-m polynomial that yields a field.
+static void _BuildField( int q, vector<vector<int> > & add, vector<vector<int> > & mul )
+{
+  int p = 2;
+  while ( q % p ) {
+    ++p;
+  }
+  int m = 0;
+  for ( int r = q; r > 1; r /= p ) {
+    if ( r % p ) {
+      cout << "Error: PolarFly requires a prime power q, got q = " << q << endl;
+      exit(-1);
+    }
+    ++m;
+  }
+
+  add.assign(q, vector<int>(q));
+  for ( int a = 0; a < q; ++a ) {
+    for ( int b = 0; b < q; ++b ) {
+      int sum = 0;
+      for ( int d = 0, w = 1; d < m; ++d, w *= p ) {
+	sum += ( ( a / w + b / w ) % p ) * w;
+      }
+      add[a][b] = sum;
+    }
+  }
+
+  // f(x) = x^m + low(x), low given by its base-p digits
+  for ( int low = 0; low < q; ++low ) {
+    mul.assign(q, vector<int>(q));
+    for ( int a = 0; a < q; ++a ) {
+      for ( int b = 0; b < q; ++b ) {
+	vector<int> prod(2 * m, 0);
+	for ( int i = 0, wi = 1; i < m; ++i, wi *= p ) {
+	  for ( int j = 0, wj = 1; j < m; ++j, wj *= p ) {
+	    prod[i + j] += ( a / wi % p ) * ( b / wj % p );
+	  }
+	}
+	// x^d = -low(x) * x^(d-m) for d >= m
+	for ( int d = 2 * m - 1; d >= m; --d ) {
+	  int const c = prod[d] % p;
+	  prod[d] = 0;
+	  for ( int i = 0, w = 1; i < m; ++i, w *= p ) {
+	    prod[d - m + i] += ( p - c ) * ( low / w % p );
+	  }
+	}
+	int value = 0;
+	for ( int i = 0, w = 1; i < m; ++i, w *= p ) {
+	  value += ( prod[i] % p ) * w;
+	}
+	mul[a][b] = value;
+      }
+    }
+    bool field = true;
+    for ( int a = 1; field && ( a < q ); ++a ) {
+      field = ( find(mul[a].begin(), mul[a].end(), 1) != mul[a].end() );
+    }
+    if ( field ) {
+      return;
+    }
+  }
+  cout << "Error: no irreducible polynomial found for GF(" << q << ")" << endl;
+  exit(-1);
+}
+
+// Erdos-Renyi polarity graph: the points of PG(2,q), with x adjacent to y
+// when x.y = 0. The q+1 absolute points (x.x = 0) get a self-loop.
+static void _GeneratePolarity( int q )
+{
+  vector<vector<int> > add, mul;
+  _BuildField(q, add, mul);
+
+  // normalized representatives: (1,a,b), (0,1,a), (0,0,1)
+  vector<vector<int> > points;
+  for ( int a = 0; a < q; ++a ) {
+    for ( int b = 0; b < q; ++b ) {
+      points.push_back(vector<int>{1, a, b});
+    }
+  }
+  for ( int a = 0; a < q; ++a ) {
+    points.push_back(vector<int>{0, 1, a});
+  }
+  points.push_back(vector<int>{0, 0, 1});
+
+  int const n = points.size();
+  vector<vector<bool> > adj(n, vector<bool>(n));
+  for ( int x = 0; x < n; ++x ) {
+    for ( int y = 0; y < n; ++y ) {
+      int dot = 0;
+      for ( int i = 0; i < 3; ++i ) {
+	dot = add[dot][mul[points[x][i]][points[y][i]]];
+      }
+      adj[x][y] = ( dot == 0 );
+    }
+  }
+
+  vector<int> order;
+  for ( int x = 0; x < n; ++x ) {
+    if ( adj[x][x] ) {
+      order.push_back(x);
+    }
+  }
+  for ( int x = 0; x < n; ++x ) {
+    if ( !adj[x][x] ) {
+      order.push_back(x);
+    }
+  }
+  vector<int> group(n);
+  for ( int g = 0; g < n; ++g ) {
+    group[order[g]] = g;
+  }
+
+  polarfly_connection_table.assign(n, vector<int>());
+  for ( int g = 0; g < n; ++g ) {
+    int const x = order[g];
+    for ( int h = 0; h < n; ++h ) {
+      if ( ( h != g ) && adj[x][order[h]] ) {
+	polarfly_connection_table[g].push_back(h);
+      }
+    }
+    if ( adj[x][x] ) {
+      polarfly_connection_table[g].push_back(g);
+    }
+  }
+}
+
+static void _ReadTable( string const & file_name )
+{
+  ifstream table_file(file_name.c_str());
+  if ( !table_file.is_open() ) {
+    cout << "Error: can't open PolarFly table file " << file_name << endl;
+    exit(-1);
+  }
+  polarfly_connection_table.clear();
+  string line;
+  while ( getline(table_file, line) ) {
+    size_t const comment = line.find("//");
+    if ( comment != string::npos ) {
+      line.erase(comment);
+    }
+    replace(line.begin(), line.end(), ',', ' ');
+    istringstream row_stream(line);
+    vector<int> row;
+    int group;
+    while ( row_stream >> group ) {
+      row.push_back(group);
+    }
+    if ( !row.empty() ) {
+      polarfly_connection_table.push_back(row);
+    }
+  }
+}
+
+static void _CheckTable( string const & source )
+{
+  int const rows = polarfly_connection_table.size();
+  int const cols = rows ? polarfly_connection_table[0].size() : 0;
+  for ( int g = 0; g < rows; ++g ) {
+    bool valid = ( (int)polarfly_connection_table[g].size() == cols );
+    for ( int i = 0; valid && ( i < cols ); ++i ) {
+      int const h = polarfly_connection_table[g][i];
+      valid = ( h >= 0 ) && ( h < rows ) &&
+	( find(polarfly_connection_table[h].begin(),
+	       polarfly_connection_table[h].end(), g) !=
+	  polarfly_connection_table[h].end() );
+    }
+    if ( !valid ) {
+      cout << "Error: invalid PolarFly table " << source << " at group " << g << endl;
+      exit(-1);
+    }
+  }
+  if ( rows == 0 ) {
+    cout << "Error: empty PolarFly table " << source << endl;
+    exit(-1);
+  }
+}
+
+void InitializePolarFlyTable( const Configuration & config, int polarfly_ports )
+{
+  string const source = config.GetStr( "polarfly_table" );
+  int const q = ( polarfly_ports > 0 ) ? ( polarfly_ports - 1 ) : 0;
+
+  if ( ( source == "auto" ) || ( source == "er" ) ) {
+    if ( ( source == "er" ) || !_LoadPreset(q) ) {
+      if ( q < 2 ) {
+	cout << "Error: PolarFly requires at least 3 ports, got " << polarfly_ports << endl;
+	exit(-1);
+      }
+      _GeneratePolarity(q);
+    }
+  } else {
+    _ReadTable(source);
+  }
+  _CheckTable(source);
+
+  polarfly_table_rows = polarfly_connection_table.size();
+  polarfly_table_cols = polarfly_connection_table[0].size();
+  if ( ( polarfly_ports > 0 ) && ( polarfly_table_cols != polarfly_ports ) ) {
+    cout << "Error: PolarFly table " << source << " has " << polarfly_table_cols
+	 << " ports per group, expected " << polarfly_ports << endl;
+    exit(-1);
+  }
+}
+
+int PolarFlyPlusHypercubePorts( const Configuration & config )
+{
+  int const ports = config.GetInt( "hypercubeport" );
+  return ( ports < 0 ) ? config.GetInt( "k" ) : ports;
+}
+
+int PolarFlyPlusPolarFlyPorts( const Configuration & config )
+{
+  int const ports = config.GetInt( "polarflyport" );
+  return ( ports < 0 ) ? config.GetInt( "n" ) : ports;
+}
+
+void ResizePolarFlyTables( int routers, int ports )
+{
+  total_node = routers;
+  node_port = ports;
+  fault_table.assign(total_node, vector<bool>(node_port, false));
+  fault_nodes.assign(total_node, false);
+  traffic_table.assign(total_node, vector<int>(node_port, 0));
+}
+
+void ResizeCollectiveTables( int routers, int nodes, int nics )
+{
+  int steps = max(8, nics);
+  // traffic patterns and the traffic manager index rows by node / nics
+  int rows = max(routers, nodes / max(nics, 1));
+  if ( gSingleSwitch ) {
+    // the single switch keeps the step of every node in row 0
+    steps = max(steps, nodes);
+    rows = max(rows, nodes);
+  }
+  step_table.assign(rows, vector<int>(steps, 0));
+  delay_table.assign(nodes, 0);
+  cycle_table.assign(nodes, 0);
+  if ( (int)fault_nodes.size() < rows ) {
+    fault_nodes.resize(rows, false);
+  }
+}
@@ -28,6 +28,20 @@
 #include "random_utils.hpp"
 #include <algorithm>
 #include <cassert>
+#include <iostream>
+#include <cstdlib>
+
+thread_local bool gParallelPhase = false;
+
+bool gRandomStreams = false;
+thread_local RandomStream * gRandomStream = NULL;
+
+void RandomParallelError( ) {
+  std::cout << "Error: the random number generator cannot be used while "
+	    << "the network is evaluated by multiple threads (threads > 1) "
+	    << "unless rng = stream." << std::endl;
+  exit(-1);
+}
 
 extern long ran_x[];
 extern double ran_u[];
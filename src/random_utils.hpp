@@ -36,27 +36,124 @@ long   ran_next( );
 void   ranf_start(long seed);
 double ranf_next( );
 
+// Counter-based generator: the n-th number of a stream is a hash of the
+// stream key and n, so streams need no shared state and can be skipped
+// ahead or filled in batches.
+class RandomStream {
+  unsigned long long _key;
+  unsigned long long _counter;
+
+  static unsigned long long const kGamma = 0x9e3779b97f4a7c15ULL;
+
+  // SplitMix64 finalizer
+  static inline unsigned long long _Mix( unsigned long long z ) {
+    z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+    return z ^ ( z >> 31 );
+  }
+  static inline double _ToFloat( unsigned long long z ) {
+    return ( z >> 11 ) * ( 1.0 / 9007199254740992.0 );
+  }
+
+public:
+  // owners of streams; a stream is identified by seed, kind and index
+  enum Kind { traffic_manager, injection, traffic, router, faults };
+
+  RandomStream( ) : _key( 0 ), _counter( 0 ) { }
+  RandomStream( long seed, Kind kind, int index ) { Seed( seed, kind, index ); }
+
+  inline void Seed( long seed, Kind kind, int index ) {
+    _key = _Mix( _Mix( (unsigned long long)seed + kGamma ) ^
+		 ( ( (unsigned long long)kind << 48 ) + (unsigned long long)index ) );
+    _counter = 0;
+  }
+
+  inline unsigned long long Next( ) {
+    return _Mix( _key + ( ++_counter ) * kGamma );
+  }
+  // integer in [0,max]
+  inline int Int( int max ) {
+    return (int)( Next( ) % (unsigned long long)( max + 1 ) );
+  }
+  // floating-point value in [0,1)
+  inline double Float( ) {
+    return _ToFloat( Next( ) );
+  }
+  // the next count values of Float() at once
+  inline void Floats( double * out, int count ) {
+    unsigned long long const base = _counter + 1;
+    for ( int i = 0; i < count; ++i ) {
+      out[i] = _ToFloat( _Mix( _key + ( base + i ) * kGamma ) );
+    }
+    _counter += count;
+  }
+};
+
+// rng = stream: the traffic manager, the traffic patterns, the injection
+// processes, every router and the fault injection draw from streams of their
+// own, and the Random* functions below use the stream of the caller
+extern bool gRandomStreams;
+extern thread_local RandomStream * gRandomStream;
+
+// makes stream the stream of the calling thread for the lifetime of the
+// object; a no-op unless rng = stream
+class RandomStreamScope {
+  RandomStream * _saved;
+public:
+  RandomStreamScope( RandomStream * stream ) : _saved( gRandomStream ) {
+    if ( gRandomStreams ) gRandomStream = stream;
+  }
+  ~RandomStreamScope( ) { gRandomStream = _saved; }
+};
+
+// Set while a thread runs its share of a parallel network phase. The global
+// generator is shared by all threads, so drawing from it there would make
+// the results depend on thread timing.
+extern thread_local bool gParallelPhase;
+void RandomParallelError( );
+
 inline void RandomSeed( long seed ) {
   ran_start( seed );
   ranf_start( seed );
 }
 
+// draws the link or node faults of a network from fail_seed: reseeds the
+// global generator, and with rng = stream the faults come from a stream of
+// their own for the lifetime of the object
+class RandomFaultScope {
+  RandomStream _stream;
+  RandomStreamScope _scope;
+public:
+  RandomFaultScope( long fail_seed )
+    : _stream( fail_seed, RandomStream::faults, 0 ), _scope( &_stream ) {
+    RandomSeed( fail_seed );
+  }
+};
+
 inline unsigned long RandomIntLong( ) {
+  if ( gRandomStream ) return gRandomStream->Next( );
+  if ( gParallelPhase ) RandomParallelError( );
   return ran_next( );
 }
 
 // Returns a random integer in the range [0,max]
 inline int RandomInt( int max ) {
+  if ( gRandomStream ) return gRandomStream->Int( max );
+  if ( gParallelPhase ) RandomParallelError( );
   return ( ran_next( ) % (max+1) );
 }
 
 // Returns a random floating-point value in the rage [0,1]
 inline double RandomFloat(  ) {
+  if ( gRandomStream ) return gRandomStream->Float( );
+  if ( gParallelPhase ) RandomParallelError( );
   return ranf_next( );
 }
 
 // Returns a random floating-point value in the rage [0,max]
 inline double RandomFloat( double max ) {
+  if ( gRandomStream ) return gRandomStream->Float( ) * max;
+  if ( gParallelPhase ) RandomParallelError( );
   return ( ranf_next( ) * max );
 }
 
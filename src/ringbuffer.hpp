@@ -0,0 +1,130 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _RINGBUFFER_HPP_
+#define _RINGBUFFER_HPP_
+
+#include <vector>
+#include <cassert>
+
+using namespace std;
+
+// A FIFO in a power-of-two ring. The ring doubles when it is full and halves
+// when it drains to a quarter of its capacity, so a queue that was deep once
+// does not keep its memory once it is idle again. reserve() allocates the
+// ring up front and keeps it from shrinking below that size.
+template<class T> class RingBuffer {
+  vector<T> _data;
+  size_t _head;
+  size_t _size;
+  size_t _mask;
+  size_t _min_capacity;
+
+  void _Resize( size_t capacity );
+
+public:
+  class iterator {
+    RingBuffer * _ring;
+    size_t _i;
+  public:
+    iterator( RingBuffer * ring, size_t i ) : _ring( ring ), _i( i ) { }
+    inline T & operator*( ) const { return _ring->_data[( _ring->_head + _i ) & _ring->_mask]; }
+    inline T * operator->( ) const { return &**this; }
+    inline iterator & operator++( ) { ++_i; return *this; }
+    inline bool operator==( iterator const & other ) const { return _i == other._i; }
+    inline bool operator!=( iterator const & other ) const { return _i != other._i; }
+  };
+
+  RingBuffer( ) : _head( 0 ), _size( 0 ), _mask( 0 ), _min_capacity( 4 ) { }
+
+  void reserve( size_t capacity );
+  inline void clear( ) { _head = 0; _size = 0; }
+
+  inline iterator begin( ) { return iterator( this, 0 ); }
+  inline iterator end( ) { return iterator( this, _size ); }
+
+  inline bool empty( ) const { return _size == 0; }
+  inline size_t size( ) const { return _size; }
+  inline size_t capacity( ) const { return _data.size( ); }
+
+  inline T & front( ) { assert( _size ); return _data[_head]; }
+  inline T const & front( ) const { assert( _size ); return _data[_head]; }
+  inline T & back( ) { assert( _size ); return _data[( _head + _size - 1 ) & _mask]; }
+  inline T const & back( ) const { assert( _size ); return _data[( _head + _size - 1 ) & _mask]; }
+  inline T const & operator[]( size_t i ) const { 
+    assert( i < _size ); 
+    return _data[( _head + i ) & _mask]; 
+  }
+
+  inline void push_back( T const & val )
+  {
+    if ( _size == _data.size( ) ) {
+      _Resize( _data.empty( ) ? _min_capacity : 2 * _data.size( ) );
+    }
+    _data[( _head + _size ) & _mask] = val;
+    ++_size;
+  }
+
+  inline void pop_front( )
+  {
+    assert( _size );
+    _head = ( _head + 1 ) & _mask;
+    --_size;
+    if ( ( _data.size( ) > _min_capacity ) && ( 4 * _size <= _data.size( ) ) ) {
+      _Resize( _data.size( ) / 2 );
+    }
+  }
+};
+
+template<class T> void RingBuffer<T>::reserve( size_t capacity )
+{
+  size_t size = 1;
+  while ( size < capacity ) {
+    size *= 2;
+  }
+  if ( size > _min_capacity ) {
+    _min_capacity = size;
+  }
+  if ( _data.size( ) < _min_capacity ) {
+    _Resize( _min_capacity );
+  }
+}
+
+template<class T> void RingBuffer<T>::_Resize( size_t capacity )
+{
+  assert( capacity >= _size );
+  assert( ( capacity & ( capacity - 1 ) ) == 0 );
+  vector<T> data( capacity );
+  for ( size_t i = 0; i < _size; ++i ) {
+    data[i] = _data[( _head + i ) & _mask];
+  }
+  _data.swap( data );
+  _head = 0;
+  _mask = capacity - 1;
+}
+
+#endif
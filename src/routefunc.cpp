@@ -52,15 +52,39 @@
 #include "tree4.hpp"
 #include "qtree.hpp"
 #include "cmesh.hpp"
+#include "collective.hpp"
 #include "polarfly_tables.hpp"
+#include "polarfly_route_table.hpp"
 
-#define VCNUM 3 //Total VC: VCNUM*2 (Request+Reply)
 map<string, tRoutingFunction> gRoutingFunctionMap;
-int  Hypercubeport,Polarflyport;
+int  Hypercubeport,Polarflyport,NumNIC,_threshold;
+bool pfp_first_minimal;
 /* Global information used by routing functions */
 int Faultescape=0;
 int gNumVCs;
 
+// Counts a flit of a collective at its source and destination routers for
+// the step counters of the NIC, and keeps step_table in line with them.
+// Random traffic leaves the counters alone.
+static void collective_count( const Router *r, const Flit *f, int nicno,
+			      bool at_src, bool at_dest, int rxnic )
+{
+  if ( gCollective == COLLECTIVE_NONE ) {
+    return;
+  }
+  const int id = r->GetID( );
+  int cur_step = r->step_cal(nicno);
+  step_table[id][nicno] = cur_step;
+  if ( at_src ) {
+    r->tx_count(cur_step,_threshold,nicno);
+    step_table[id][nicno] = r->step_cal(nicno);
+  }
+  if ( at_dest ) {
+    r->rx_count(f->step,_threshold,rxnic);
+    step_table[id][rxnic] = r->step_cal(rxnic);
+  }
+}
+
 /* Add more functions here
  *
  */
@@ -295,12 +319,19 @@ void fattree_nca( const Router *r, const Flit *f,
     int router_neighborhood = pos/routers_per_neighborhood; //coverage of this tree
     int router_coverage = powi(gK, gN-router_depth);  //span of the tree from this router
     
+    // the steps are counted per attached node
+    const int nicno = f->src;
+#ifdef FATTREE_ROUTING_DEBUG
+      cout << "id:" << f->pid << " src:" << f->src << " dest:" << f->dest << " router:" << r->GetID( ) << " nic:" << nicno <<  " tx_step:" << r->Get_tx_step(nicno) <<  " rx_step:" << r->Get_rx_step(nicno) << " fstep:" << f->step << endl;
+#endif
+    // collective schedules count a reception at the receiving node
+    collective_count( r, f, nicno, router_id == f->src/gK, router_id == dest/gK,
+		      Router::GetCollectiveSchedule( ) ? dest : nicno );
 
     //NCA reached going down
     if(dest <(router_neighborhood+1)* router_coverage && 
        dest >=router_neighborhood* router_coverage){
       //down ports are numbered first
-
       //ejection
       if(router_depth == gN-1){
 	out_port = dest%gK;
@@ -645,8 +676,31 @@ void dor_next_torus( int cur, int dest, int in_port,
 
 void dim_order_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *outputs, bool inject )
 {
+#ifdef MESH_ROUTING_DEBUG
 	cout << "     routefunc mesh routing start : cur " << r << " dest " << f->dest << " in_port " << in_channel << " in_vc " << f->vc << endl;
-  int out_port = inject ? -1 : dor_next_mesh( r->GetID( ), f->dest );
+#endif
+  outputs->Clear();
+  int out_port = -1;
+  if(inject){
+    if ( gCollective != COLLECTIVE_NONE ) {
+      // collectives inject on VC 0 only
+      outputs->AddRange( -1, 0, 0);
+      return;
+    }
+  } else {
+    // the nodes of a router are numbered consecutively
+    const int cur = r->GetID( );
+    const int dest = f->dest / NumNIC;
+    const int nicno = f->src % NumNIC;
+#ifdef HCUBE_ROUTING_DEBUG
+      cout << "id:" << f->pid << " src:" << f->src << " dest:" << f->dest << " router:" << cur <<  " tx_step:" << r->Get_tx_step(nicno) <<  " rx_step:" << r->Get_rx_step(nicno) << " fstep:" << f->step << endl;
+#endif 
+    collective_count( r, f, nicno, cur == f->src / NumNIC, cur == dest, nicno );
+    out_port = dor_next_mesh( cur, dest );
+    if ( out_port == 2*gN ) {
+      out_port += f->dest % NumNIC; // Eject
+    }
+  }
   
   int vcBegin = 0, vcEnd = gNumVCs-1;
   if ( f->type == Flit::READ_REQUEST ) {
@@ -676,8 +730,6 @@ void dim_order_mesh( const Router *r, const Flit *f, int in_channel, OutputSet *
 	       << "." << endl;
   }
   
-  outputs->Clear();
-
   outputs->AddRange( out_port, vcBegin, vcEnd );
 }
 
@@ -1574,7 +1626,6 @@ void dim_order_torus( const Router *r, const Flit *f, int in_channel,
     vcEnd = gWriteReplyEndVC;
   }
   assert(((f->vc >= vcBegin) && (f->vc <= vcEnd)) || (inject && (f->vc < 0)));
-
   int out_port;
 
   if(inject) {
@@ -1582,12 +1633,18 @@ void dim_order_torus( const Router *r, const Flit *f, int in_channel,
     out_port = -1;
 
   } else {
-    
+    const int nicno = f->src % NumNIC;
     int cur  = r->GetID( );
-    int dest = f->dest;
-
+    int dest = f->dest / NumNIC;
+#ifdef TORUS_ROUTING_DEBUG
+      cout << "id:" << f->pid << " src:" << f->src << " dest:" << f->dest << " router:" << r->GetID( ) <<  " tx_step:" << r->Get_tx_step(nicno) <<  " rx_step:" << r->Get_rx_step(nicno) << " fstep:" << f->step << endl;
+#endif
+    collective_count( r, f, nicno, cur == f->src / NumNIC, cur == dest, nicno );
     dor_next_torus( cur, dest, in_channel,
 		    &out_port, &f->ph, false );
+    if ( out_port == 2*gN ) {
+      out_port += f->dest % NumNIC; // Eject
+    }
 
 
     // at the destination router, we don't need to separate VCs by ring partition
@@ -1784,6 +1841,7 @@ void min_adapt_torus( const Router *r, const Flit *f, int in_channel, OutputSet
   } else if(r->GetID() == f->dest) {
     // ejection can also use all VCs
     outputs->AddRange(2*gN, vcBegin, vcEnd);
+    return;
   }
 
   int in_vc;
@@ -1980,7 +2038,7 @@ int polarport_cal(int src_grp, int dest_grp){
        }
     }
     assert(global_port>-1);
-    global_port += Hypercubeport + 1; //local port offset + eject port offset
+    global_port += Hypercubeport + NumNIC; //local port offset + eject port offset
     return global_port;
 }
 
@@ -2024,7 +2082,7 @@ tuple<int,int> hyperport_cal(int hypercube_mv, int in_dim_order, int in_vc){
         if(in_vc==VCNUM+2){dim = order5[i];}
  	if(((hypercube_mv >> dim) & 1) == 1){
 	     out_dim_order = i+1;
-	     out_port = dim+1;
+	     out_port = dim+NumNIC;
              break;
 	}
      }
@@ -2055,7 +2113,6 @@ int polarfly_fault_escape(int src_grp, int in_port, int global_port){
 */
 
 //===================source routing=====================
-int traffic_table[total_node][node_port] = {0};
 struct LocalMoveResult {
     int current;
     int local_move;
@@ -2063,7 +2120,7 @@ struct LocalMoveResult {
     bool fault_detected;
 };
 
-LocalMoveResult process_local_move(int current, int dest, int hypercube_mv, int in_vc, int id) {
+LocalMoveResult process_local_move(int current, int dest, int hypercube_mv, int in_vc, int id, bool use_faults) {
     LocalMoveResult result = {current, 0, false, false};
     int local_port = 0;
     int dim_order=0;
@@ -2073,17 +2130,19 @@ LocalMoveResult process_local_move(int current, int dest, int hypercube_mv, int
     int mv = 0;
     for (int k = 0; k < Hypercubeport; k++) {
 	auto [dim_order_temp, local_port_temp]= hyperport_cal(hypercube_mv, dim_order, in_vc);
-	if (local_port_temp >= 0 && !fault_table[current][local_port_temp]) {
+	if (local_port_temp >= 0 && !(use_faults && fault_table[current][local_port_temp])) {
             local_port = local_port_temp;
 	    dim_order = dim_order_temp;
 #ifdef PFP_ROUTING_DEBUG
 	    cout << "source routing id:" << id << " local:" << (in_vc%VCNUM)+1 << " node" << current << " -> ";
 #endif 
-	    current ^= (1 << (local_port - 1));
-            mv ^= (1 << (local_port - 1));
+	    current ^= (1 << (local_port - NumNIC));
+            mv ^= (1 << (local_port - NumNIC));
+#ifdef PFP_ROUTING_DEBUG
 	    cout << "node" << current << endl;
+#endif
         }
-        else if (fault_table[current][local_port_temp]) {
+        else if (local_port_temp >= 0) {
 #ifdef PFP_ROUTING_DEBUG
     		cout << "source routing id:" << id << " local:" << (in_vc%VCNUM)+1 << " node" << current << " port" << local_port_temp << " err" << endl;
 #endif    
@@ -2111,15 +2170,15 @@ struct GlobalMoveResult {
     bool routing_complete;
 };
 
-GlobalMoveResult process_global_move(int current, int current_group, int dest_group, int phase, int id) {
+GlobalMoveResult process_global_move(int current, int current_group, int dest_group, int phase, int id, bool use_faults) {
     GlobalMoveResult result = {current, current_group, 0, false};
     
     int global_port = polarport_cal(current_group, dest_group);
-    if (!fault_table[current][global_port]) {
+    if (!(use_faults && fault_table[current][global_port])) {
 #ifdef PFP_ROUTING_DEBUG
    	  cout << "source routing id:" << id << " grp" << current_group << " -> ";
 #endif
-        current_group = polarfly_connection_table[current_group][global_port - Hypercubeport - 1];
+        current_group = polarfly_connection_table[current_group][global_port - Hypercubeport - NumNIC];
 #ifdef PFP_ROUTING_DEBUG
 	cout << "grp" << current_group << endl;
 #endif
@@ -2143,114 +2202,117 @@ GlobalMoveResult process_global_move(int current, int current_group, int dest_gr
     return result;
 }
 
-void source_routing(const Flit *f, int current_node, int destination_node) {
+// Try one split of the hypercube moves into the three local phases.
+// path: localmv1, localmv2, localmv3, global1, global2
+bool try_source_route(int current_node, int destination_node,
+                      int hypercube_mv1, int hypercube_mv2, int hypercube_mv3,
+                      int in_vc, int id, bool use_faults, int path[5]) {
+    int local_move1 = 0, local_move2 = 0, local_move3 = 0;
+    int global_port1 = 0, global_port2 = 0;
+    int current = current_node;
+    const int dest = destination_node;
+    int current_group = current >> Hypercubeport;
+    const int dest_group = dest >> Hypercubeport;
+#ifdef PFP_ROUTING_DEBUG
+    cout << "source routing id:" << id << " hypercube hops:" << bitset<8>(hypercube_mv1) << " " << bitset<8>(hypercube_mv2) << " " << bitset<8>(hypercube_mv3) << endl;
+#endif
+    bool local_routing_complete = (bitmask(current, Hypercubeport) == bitmask(dest, Hypercubeport));
+    bool global_routing_complete = (current_group == dest_group);
+
+    // local move 1
+    if (hypercube_mv1 > 0) {
+        auto result = process_local_move(current, dest, hypercube_mv1, in_vc, id, use_faults);
+        if (result.fault_detected) return false;
+        current = result.current;
+        local_move1 = result.local_move;
+        local_routing_complete = result.routing_complete;
+    }
+    if (!(local_routing_complete && global_routing_complete)) {
+        // global move 1
+        if (!global_routing_complete) {
+            auto result = process_global_move(current, current_group, dest_group, 1, id, use_faults);
+            if (result.global_port == 0) return false;
+            current = result.current;
+            current_group = result.current_group;
+            global_port1 = result.global_port;
+            global_routing_complete = result.routing_complete;
+        }
+        if((global_port1 == 0) && (local_move1 == 0)) return false;
+    }
+    if (!(local_routing_complete && global_routing_complete)) {
+        // local move 2
+        if (hypercube_mv2 > 0) {
+            auto result = process_local_move(current, dest, hypercube_mv2, in_vc+1, id, use_faults);
+            if (result.fault_detected) return false;
+            current = result.current;
+            local_move2 = result.local_move;
+            local_routing_complete = result.routing_complete;
+        }
+    }
+    if (!(local_routing_complete && global_routing_complete)) {
+        // global move 2
+        if (!global_routing_complete) {
+            auto result = process_global_move(current, current_group, dest_group, 2, id, use_faults);
+            if (result.global_port == 0) return false;
+            current = result.current;
+            current_group = result.current_group;
+            global_port2 = result.global_port;
+            global_routing_complete = result.routing_complete;
+        }
+        if((global_port2 == 0) && (local_move2 == 0)) return false;
+    }
+    if (!(local_routing_complete && global_routing_complete)) {
+        // local move 3
+        if (hypercube_mv3 > 0) {
+            auto result = process_local_move(current, dest, hypercube_mv3, in_vc+2, id, use_faults);
+            if (result.fault_detected) return false;
+            current = result.current;
+            local_move3 = result.local_move;
+            local_routing_complete = result.routing_complete;
+        }
+    }
+    if (!(local_routing_complete && global_routing_complete)) return false;
+    path[0] = local_move1;
+    path[1] = local_move2;
+    path[2] = local_move3;
+    path[3] = global_port1;
+    path[4] = global_port2;
+    return true;
+}
+
+PolarFlyRoute compute_source_route(int current_node, int destination_node, int in_vc, int id, bool use_faults) {
     int local_move1 = 0, local_move2 = 0, local_move3 = 0;
     int global_port1 = 0, global_port2 = 0;
+#ifdef PFP_ROUTING_DEBUG
     int routing_result = 0;
     int min_ok_weight = 0;
+#endif
     vector<vector<int>> oklist; //localmv1, localmv2, localmv3, global1, blobal2, weight
-    int in_vc=f->vc;
-    if ( f->type == Flit::READ_REPLY || f->type == Flit::WRITE_REPLY) {
-        in_vc+=VCNUM; //reply inject
-    }
     int hypercube_moves = bitmask(current_node, Hypercubeport) ^ bitmask(destination_node, Hypercubeport);
     bitset<8> bit_min(hypercube_moves);
     int min_weight = bit_min.count();
 
-    make_order();
+    // The preferred path has the lowest weight, so only the splits of the
+    // lightest weight class that yields a usable path have to be tried.
+    vector<vector<pair<int,int> > > splits(3*Hypercubeport+1);
     for (int i = 0; i < (1<<Hypercubeport); i++) {
-        bool local_routing_complete = false;
-        bool global_routing_complete = false;
 	for (int j = 0 ; j < (1<<Hypercubeport); j++) {
-	    local_move1 = 0; local_move2 = 0; local_move3 = 0;
-	    global_port1 = 0; global_port2 = 0;
-            int current = current_node;
-            const int dest = destination_node;
-            int current_group = current >> Hypercubeport;
-            const int dest_group = dest >> Hypercubeport;
-            int hypercube_mv3 = j;
-	    int hypercube_mv2 = i;
-	    int hypercube_mv1 = hypercube_moves^i^j; 
-	    bitset<8> bit1(hypercube_mv1);
-	    bitset<8> bit2(hypercube_mv2);
-	    bitset<8> bit3(hypercube_mv3);
-	    int weight = bit1.count() + bit2.count() + bit3.count();
-#ifdef PFP_ROUTING_DEBUG
-      	    cout << "source routing id:" << f->pid << " hypercube hops:" << bitset<8>(hypercube_mv1) << " " << bitset<8>(hypercube_mv2) << " " << bitset<8>(hypercube_mv3) << endl;
-#endif
-            local_routing_complete = (bitmask(current, Hypercubeport) == bitmask(dest, Hypercubeport));
-            global_routing_complete = (current_group == dest_group);
-
-            // local move 1
-            if (hypercube_mv1 > 0) {
-                auto result = process_local_move(current, dest, hypercube_mv1, in_vc, f->pid);
-                if (result.fault_detected) continue;
-                current = result.current;
-                local_move1 = result.local_move;
-                local_routing_complete = result.routing_complete;
-            }
-            if (local_routing_complete && global_routing_complete) {
-	        vector<int> okpath = {local_move1,local_move2,local_move3,global_port1,global_port2,weight};
-                oklist.push_back(okpath);
-                continue;	
-	    }
-            // global move 1
-            if (!global_routing_complete) {
-                auto result = process_global_move(current, current_group, dest_group, 1, f->pid);
-                if (result.global_port == 0) continue;
-                current = result.current;
-                current_group = result.current_group;
-                global_port1 = result.global_port;
-                global_routing_complete = result.routing_complete;
-            }
-	    if((global_port1 == 0) && (local_move1 == 0))continue;
-	    if (local_routing_complete && global_routing_complete){
-                vector<int> okpath = {local_move1,local_move2,local_move3,global_port1,global_port2,weight};
-                oklist.push_back(okpath);
-                continue;
-	    }
-            // local move 2
-            if (hypercube_mv2 > 0) {
-                auto result = process_local_move(current, dest, hypercube_mv2, in_vc+1, f->pid);
-                if (result.fault_detected) continue;
-                current = result.current;
-                local_move2 = result.local_move;
-                local_routing_complete = result.routing_complete;
-            }
-	    if (local_routing_complete && global_routing_complete) {
-		vector<int> okpath = {local_move1,local_move2,local_move3,global_port1,global_port2,weight};
-                oklist.push_back(okpath);
-                continue;
-	    }
-            // global move 2
-            if (!global_routing_complete) {
-                auto result = process_global_move(current, current_group, dest_group, 2, f->pid);
-                if (result.global_port == 0) continue;
-                current = result.current;
-                current_group = result.current_group;
-                global_port2 = result.global_port;
-                global_routing_complete = result.routing_complete;
-            }
-	    if((global_port2 == 0) && (local_move2 == 0))continue;
-	    if (local_routing_complete && global_routing_complete){
-	        vector<int> okpath = {local_move1,local_move2,local_move3,global_port1,global_port2,weight};
-                oklist.push_back(okpath);
-                continue;
-	    }
-            // local move 3
-            if (hypercube_mv3 > 0) {
-                auto result = process_local_move(current, dest, hypercube_mv3, in_vc+2, f->pid);
-                if (result.fault_detected) continue;
-                current = result.current;
-                local_move3 = result.local_move;
-                local_routing_complete = result.routing_complete;
-            }
-	    if (local_routing_complete && global_routing_complete){
-	        vector<int> okpath = {local_move1,local_move2,local_move3,global_port1,global_port2,weight};
-                oklist.push_back(okpath);
-                continue;
+	    int weight = __builtin_popcount(hypercube_moves^i^j) + __builtin_popcount(i) + __builtin_popcount(j);
+	    splits[weight].push_back(make_pair(i, j));
+	}
+    }
+    for (int weight = min_weight; weight <= 3*Hypercubeport && oklist.empty(); weight++) {
+	for (size_t s = 0; s < splits[weight].size(); s++) {
+	    int const hypercube_mv2 = splits[weight][s].first;
+	    int const hypercube_mv3 = splits[weight][s].second;
+	    int const hypercube_mv1 = hypercube_moves^hypercube_mv2^hypercube_mv3;
+	    int path[5];
+	    if (try_source_route(current_node, destination_node, hypercube_mv1, hypercube_mv2, hypercube_mv3, in_vc, id, use_faults, path)) {
+		vector<int> okpath = {path[0],path[1],path[2],path[3],path[4],weight};
+		oklist.push_back(okpath);
+		if(pfp_first_minimal && (weight == min_weight))break; //first minimal path is taken as is
 	    }
-        }
+	}
     }
 
     sort(oklist.begin(), oklist.end(), [](const vector<int>& a, const vector<int>& b) {
@@ -2279,35 +2341,35 @@ void source_routing(const Flit *f, int current_node, int destination_node) {
 	    bitset<8> bit3(hypercube_mv3);
 	    int weight = bit1.count() + bit2.count() + bit3.count();
 #ifdef PFP_ROUTING_DEBUG
-	    cout << "source routing id:" << f->pid << " hypercube hops:" << bitset<8>(hypercube_mv1) << " " << bitset<8>(hypercube_mv2) << " " << bitset<8>(hypercube_mv3) << " polarfly external esc"<< endl;
+	    cout << "source routing id:" << id << " hypercube hops:" << bitset<8>(hypercube_mv1) << " " << bitset<8>(hypercube_mv2) << " " << bitset<8>(hypercube_mv3) << " polarfly external esc"<< endl;
 #endif
 	    local_move1=0;local_move2=0;local_move3=0;
 	    global_port1 = 0; global_port2 = 0;
             // local move 1
             if (hypercube_mv1 > 0) {
-                auto result = process_local_move(current, dest, hypercube_mv1, in_vc, f->pid);
+                auto result = process_local_move(current, dest, hypercube_mv1, in_vc, id, use_faults);
                 if (result.fault_detected) continue;
                 current = result.current;
                 local_move1 = result.local_move;
             }
-            int dest_group_esc = polarfly_connection_table[current_group][j];
+            int dest_group_esc = polarfly_connection_table[current_group][k];
 	    if(dest_group_esc==current_group)continue; //red group last port
 	    //global move 1
-            auto result = process_global_move(current, current_group, dest_group_esc, 1, f->pid);
+            auto result = process_global_move(current, current_group, dest_group_esc, 1, id, use_faults);
             if (result.global_port == 0) continue;
             current = result.current;
             current_group = result.current_group;
             global_port1 = result.global_port;
             // local move 2
             if (hypercube_mv2 > 0) {
-                auto result = process_local_move(current, dest, hypercube_mv2, in_vc+1, f->pid);
+                auto result = process_local_move(current, dest, hypercube_mv2, in_vc+1, id, use_faults);
                 if (result.fault_detected) continue;
                 current = result.current;
                 local_move2 = result.local_move;
                 local_routing_complete = result.routing_complete;
             }
 	    //global back 2
-            result = process_global_move(current, current_group, dest_group, 2, f->pid);
+            result = process_global_move(current, current_group, dest_group, 2, id, use_faults);
             if (result.global_port == 0) continue;
             current = result.current;
             current_group = result.current_group;
@@ -2316,7 +2378,7 @@ void source_routing(const Flit *f, int current_node, int destination_node) {
 	    if(!global_routing_complete)continue;   
             //local move 3
 	    if (hypercube_mv3 > 0) {
-                auto result = process_local_move(current, dest, hypercube_mv3, in_vc+2, f->pid);
+                auto result = process_local_move(current, dest, hypercube_mv3, in_vc+2, id, use_faults);
                 if (result.fault_detected) continue;
                 current = result.current;
                 local_move3 = result.local_move;
@@ -2352,13 +2414,8 @@ void source_routing(const Flit *f, int current_node, int destination_node) {
       min_ok_weight = oklist[0][5];
 #endif
     }
-    ((int*)f->data)[0] = local_move1;
-    ((int*)f->data)[1] = local_move2;
-    ((int*)f->data)[2] = local_move3;
-    ((int*)f->data)[3] = global_port1;
-    ((int*)f->data)[4] = global_port2;
 #ifdef PFP_ROUTING_DEBUG
-    cout << "source routing id:" << f->id 
+    cout << "source routing id:" << id 
          << " src:" << current_node 
          << " dest:" << destination_node 
          << " mv:" << hypercube_moves 
@@ -2374,7 +2431,24 @@ void source_routing(const Flit *f, int current_node, int destination_node) {
     if(min_weight < min_ok_weight){cout << " non-minimal";}
 	 cout << endl;
 #endif
-	 
+    return PolarFlyRouteTable::Pack(local_move1, local_move2, local_move3, global_port1, global_port2);
+}
+
+// route table entry point: VC class 0 is request, 1 is reply
+PolarFlyRoute polarflyplus_source_route(int src, int dest, int vc_class, bool use_faults) {
+    return compute_source_route(src, dest, vc_class * VCNUM, -1, use_faults);
+}
+
+void source_routing(const Flit *f, int current_node, int destination_node) {
+    int in_vc=f->vc;
+    if ( f->type == Flit::READ_REPLY || f->type == Flit::WRITE_REPLY) {
+        in_vc+=VCNUM; //reply inject
+    }
+    if (gPolarFlyRouteTable && (in_vc % VCNUM == 0)) {
+        f->route = gPolarFlyRouteTable->Lookup(current_node, destination_node, in_vc / VCNUM);
+    } else {
+        f->route = compute_source_route(current_node, destination_node, in_vc, f->pid, true);
+    }
 }
 
 
@@ -2391,7 +2465,26 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
     int in_vc=f->vc;
     const int in_port=in_channel;
     const int cur = r->GetID( );
-    const int dest = f->dest;
+    const int dest = f->dest/NumNIC;
+    const int dest_NICno = f->dest % NumNIC;
+    const int nicno = f->src % NumNIC;
+    const int src = f->src/NumNIC;
+    if(cur==src){
+	  if(in_port < NumNIC){ //injection port
+             source_routing(f, cur, dest); // write in flits
+          }
+      f->destnic=dest_NICno;
+#ifdef PFP_ROUTING_DEBUG
+      cout << "id:" << f->pid << " router:" << r->GetID( ) <<  " tx_step:" << r->Get_tx_step(nicno) <<  " rx_step:" << r->Get_rx_step(nicno) << " fstep:" << f->step << " dest_NIC:" << dest_NICno << endl;
+#endif
+    }
+#ifdef PFP_ROUTING_DEBUG
+    if(dest == cur) {
+      cout << "id:" << f->pid << " router" << r->GetID( ) <<  " tx_step:" << r->Get_tx_step(nicno) <<  " rx_step:" << r->Get_rx_step(nicno) << " cur_step:" << r->step_cal(nicno) << " received:" << f->step <<endl;
+    }
+#endif
+    collective_count( r, f, nicno, cur == src, cur == dest, nicno );
+
     // ========for adaptive routing======= 
     //const int src_grp = cur>>Hypercubeport;
     //const int dest_grp = dest>>Hypercubeport;
@@ -2399,43 +2492,43 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
     //int local_port;
     //int escape_flag=0;
     if(dest == cur) {
+	    out_port = f->destnic; // Eject
 #ifdef PFP_ROUTING_DEBUG
-            cout << "routefunc polarfly+ id:" << f->pid << " eject" << endl;
+            cout << "routefunc polarfly+ id:" << f->pid << " src:" << f->src << " dest:" << f->dest << " cur:" << cur <<" eject port:" << out_port << endl;
 #endif
-	    out_port = 0; // Eject
 	    out_vc = in_vc;
     }
     else {
           //==================source routing==================== 
           out_port=-1;
-	  if(in_port == 0){ //injection port
-             source_routing(f, cur, dest); // write in flits
-	  }
-
-          const int local_mv1 = ((int*)f->data)[0];
-          const int local_mv2 = ((int*)f->data)[1];
-	  const int local_mv3 = ((int*)f->data)[2];
-	  const int global_port1 = ((int*)f->data)[3];
-	  const int global_port2 = ((int*)f->data)[4];
+	  //if(in_port < NumNIC){ //injection port
+          //   source_routing(f, cur, dest); // write in flits
+	  //}
+
+          const int local_mv1 = f->route.local_move[0];
+          const int local_mv2 = f->route.local_move[1];
+	  const int local_mv3 = f->route.local_move[2];
+	  const int global_port1 = f->route.global_port[0];
+	  const int global_port2 = f->route.global_port[1];
           int order=0;
-          if(in_vc == 0){for(int i=0;i<Hypercubeport;i++){if(in_port==order0[i]+1){order=i;break;}}}
-          if(in_vc == 1){for(int i=0;i<Hypercubeport;i++){if(in_port==order1[i]+1){order=i;break;}}}
-          if(in_vc == 2){for(int i=0;i<Hypercubeport;i++){if(in_port==order2[i]+1){order=i;break;}}}
-          if(in_vc == 3){for(int i=0;i<Hypercubeport;i++){if(in_port==order3[i]+1){order=i;break;}}}
-          if(in_vc == 4){for(int i=0;i<Hypercubeport;i++){if(in_port==order4[i]+1){order=i;break;}}}
-          if(in_vc == 5){for(int i=0;i<Hypercubeport;i++){if(in_port==order5[i]+1){order=i;break;}}}
-          if(in_port==0){
+          if(in_vc == 0){for(int i=0;i<Hypercubeport;i++){if(in_port==order0[i]+NumNIC){order=i;break;}}}
+          if(in_vc == 1){for(int i=0;i<Hypercubeport;i++){if(in_port==order1[i]+NumNIC){order=i;break;}}}
+          if(in_vc == 2){for(int i=0;i<Hypercubeport;i++){if(in_port==order2[i]+NumNIC){order=i;break;}}}
+          if(in_vc == 3){for(int i=0;i<Hypercubeport;i++){if(in_port==order3[i]+NumNIC){order=i;break;}}}
+          if(in_vc == 4){for(int i=0;i<Hypercubeport;i++){if(in_port==order4[i]+NumNIC){order=i;break;}}}
+          if(in_vc == 5){for(int i=0;i<Hypercubeport;i++){if(in_port==order5[i]+NumNIC){order=i;break;}}}
+          if(in_port<NumNIC){
 		  order=-1;
                   if ( f->type == Flit::READ_REPLY || f->type == Flit::WRITE_REPLY) {
                      in_vc += VCNUM; //reply inject
                   }	  
 	  }
 
-	  if(in_port <= Hypercubeport && order < Hypercubeport) { //Local receive : local move
+	  if(in_port < (Hypercubeport+NumNIC) && order < Hypercubeport) { //Local receive : local move
               for(int i = order+1; i < Hypercubeport; i++){
                 if(in_vc == 0){
       		      if((local_mv1 >> order0[i])%2==1){
-			out_port=order0[i]+1;
+			out_port=order0[i]+NumNIC;
 		        out_vc=in_vc;
 #ifdef PFP_ROUTING_DEBUG
 			cout << "routefunc polarfly+ id:" << f->pid << " local move1 port" << out_port << " vc" << out_vc << endl;
@@ -2445,7 +2538,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		}
 		else if (in_vc == 1){
                       if((local_mv2 >> order1[i])%2==1){
-                        out_port=order1[i]+1;
+                        out_port=order1[i]+NumNIC;
                         out_vc=in_vc;
 #ifdef PFP_ROUTING_DEBUG
 			cout << "routefunc polarfly+ id:" << f->pid << " local move2 port" << out_port << " vc" << out_vc << endl;
@@ -2455,7 +2548,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		}
 		else if (in_vc == 2){
                       if((local_mv3 >> order2[i])%2==1){
-                        out_port=order2[i]+1;
+                        out_port=order2[i]+NumNIC;
                         out_vc=in_vc;
 #ifdef PFP_ROUTING_DEBUG
 			cout << "routefunc polarfly+ id:" << f->pid << " local move3 port" << out_port << " vc" << out_vc << endl;
@@ -2465,7 +2558,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		}
 		else if(in_vc == 3){
 		      if((local_mv1 >> order3[i])%2==1){
-		        out_port=order3[i]+1;
+		        out_port=order3[i]+NumNIC;
 			out_vc=in_vc;
 #ifdef PFP_ROUTING_DEBUG
 			cout << "routefunc polarfly+ id:" << f->pid << " local move1 port" << out_port << " vc" << out_vc << endl;
@@ -2475,7 +2568,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		}
 		else if (in_vc == 4){
 		      if((local_mv2 >> order4[i])%2==1){
-			out_port=order4[i]+1; 
+			out_port=order4[i]+NumNIC; 
 			out_vc=in_vc;
 #ifdef PFP_ROUTING_DEBUG
 			cout << "routefunc polarfly+ id:" << f->pid << " local move2 port" << out_port << " vc" << out_vc << endl;
@@ -2485,7 +2578,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		}
 		else if (in_vc == 5){
 		      if((local_mv3 >> order5[i])%2==1){
-			out_port=order5[i]+1;
+			out_port=order5[i]+NumNIC;
 			out_vc=in_vc;
 #ifdef PFP_ROUTING_DEBUG
 			cout << "routefunc polarfly+ id:" << f->pid << " local move3 port" << out_port << " vc" << out_vc << endl;
@@ -2495,7 +2588,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		}
 	      }
 	    }
-            if((in_port <= Hypercubeport && order == Hypercubeport) || (in_port <= Hypercubeport && out_port == -1)) { 
+            if((in_port < (Hypercubeport+NumNIC) && order == Hypercubeport) || (in_port < (Hypercubeport+NumNIC) && out_port == -1)) { 
 	    //Local LSB receive or No local mv : local -> global
                if (in_vc == 0 || in_vc == 3){
                  if(global_port1>0){
@@ -2519,7 +2612,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 	         for(int i = 0; i < Hypercubeport; i++){
                      if (in_vc == 0){
                         if((local_mv2 >> order1[i])%2==1){
-	                  out_port=order1[i]+1;
+	                  out_port=order1[i]+NumNIC;
 	                  out_vc=in_vc+1;
 #ifdef PFP_ROUTING_DEBUG
 			  cout << "routefunc polarfly+ id:" << f->pid << " local move2 port" << out_port << " vc" << out_vc << " hypercube internal esc" << endl;
@@ -2529,7 +2622,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		     }
                      else if (in_vc == 1){
                         if((local_mv3 >> order2[i])%2==1){
-			  out_port=order2[i]+1;
+			  out_port=order2[i]+NumNIC;
 			  out_vc=in_vc+1;
 #ifdef PFP_ROUTING_DEBUG
 			  cout << "routefunc polarfly+ id:" << f->pid << " local move3 port" << out_port << " vc" << out_vc << " hypercube internal esc"<< endl;
@@ -2539,7 +2632,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		     }
 		     else if (in_vc == 3){
            	        if((local_mv2 >> order4[i])%2==1){
-			  out_port=order4[i]+1;
+			  out_port=order4[i]+NumNIC;
 		          out_vc=in_vc+1;
 #ifdef PFP_ROUTING_DEBUG
 			  cout << "routefunc polarfly+ id:" << f->pid << " local move2 port" << out_port << " vc" << out_vc << " hypercube internal esc" << endl;
@@ -2549,7 +2642,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		     }
 		     else if (in_vc == 4){
 			if((local_mv3 >> order5[i])%2==1){
-		          out_port=order5[i]+1;
+		          out_port=order5[i]+NumNIC;
 		          out_vc=in_vc+1;
 #ifdef PFP_ROUTING_DEBUG
 			  cout << "routefunc polarfly+ id:" << f->pid << " local move3 port" << out_port << " vc" << out_vc << " hypercube internal esc" << endl;
@@ -2560,11 +2653,11 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		  }
 	       }
    	    }
-            if(in_port > Hypercubeport) {  //Global receive: global -> local move 
+            if(in_port >= Hypercubeport+NumNIC) {  //Global receive: global -> local move 
               for(int i = 0;i < Hypercubeport ; i++){
                 if (in_vc == 0){  
       		      if((local_mv2 >> order1[i])%2==1){
-                        out_port=order1[i]+1;
+                        out_port=order1[i]+NumNIC;
                         out_vc=in_vc+1;
 #ifdef PFP_ROUTING_DEBUG
 			cout << "routefunc polarfly+ id:" << f->pid << " local move2 port" << out_port << " vc" << out_vc << endl;
@@ -2574,7 +2667,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		 }
 		 else if (in_vc == 1){
                       if((local_mv3 >> order2[i])%2==1){
-                        out_port=order2[i]+1;
+                        out_port=order2[i]+NumNIC;
                         out_vc=in_vc+1;
 #ifdef PFP_ROUTING_DEBUG
 			cout << "routefunc polarfly+ id:" << f->pid << " local move3 port" << out_port << " vc" << out_vc << endl;
@@ -2584,7 +2677,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
 		 }
 		 else if (in_vc == 3){
                       if((local_mv2 >> order4[i])%2==1){
-                        out_port=order4[i]+1;
+                        out_port=order4[i]+NumNIC;
                         out_vc=in_vc+1;
 #ifdef PFP_ROUTING_DEBUG
       			cout << "routefunc polarfly+ id:" << f->pid << " local move2 port" << out_port << " vc" << out_vc << endl;
@@ -2594,7 +2687,7 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
                  }
                  else if (in_vc == 4){
                       if((local_mv3 >> order5[i])%2==1){
-                        out_port=order5[i]+1;
+                        out_port=order5[i]+NumNIC;
                         out_vc=in_vc+1;
 #ifdef PFP_ROUTING_DEBUG
 			cout << "routefunc polarfly+ id:" << f->pid << " local move3 port" << out_port << " vc" << out_vc << endl;
@@ -2705,35 +2798,38 @@ void dim_order_polarflyplus( const Router *r, const Flit *f, int in_channel,
                   }
 		  if (out_port > -1 ) out_vc = in_vc + 1;
            }
-*/
+*/	
+
 #ifdef PFP_ROUTING_DEBUG
-	   if(out_port==-1){cout << "routefunc polarfly+ router:" << r->FullName() << "#" << r->GetID( ) << " id:" << f->pid << " outporterr" << endl;}
-#endif    
-assert(out_port > -1);
-    } 
-    
+	   if(out_port==-1){
+                cout << "routefunc polarfly+ router:" << r->FullName() << "#" << r->GetID( ) << " id:" << f->pid << " outporterr" << " fstep:" << f->step << endl;
+	   }
+#endif
+          assert(out_port > -1);
+    }
+
+
 #ifdef PFP_ROUTING_DEBUG
     cout << "routefunc polarfly+ router:" << r->FullName() << "#" << r->GetID( ) << " id:" << f->pid << " src:" << f->src << " dest:" << f->dest << " in_p" << in_channel << "_vc" << f->vc << " out_p" << out_port << "_vc" << out_vc << " type:" << f->type << endl;
-   //VC chk
+    //VC chk
    cout << "routefunc polarfly+ id:" << f->pid << " vc chk" << endl;
 #endif
    if ( f->type == Flit::READ_REQUEST || f->type == Flit::WRITE_REQUEST) {
 #ifdef PFP_ROUTING_DEBUG
     	   if((cur!=dest) && ((out_vc < 0) || (out_vc > VCNUM-1)))cout << "routefunc polarfly+ id:" << f->pid << " vcerr:" << out_vc << endl; 
 #endif
-    	   assert((cur==dest) || ((out_vc >= 0) && (out_vc <= VCNUM-1))); //pending or VC0-2
+       assert((cur==dest) || ((out_vc >= 0) && (out_vc <= VCNUM-1))); //pending or VC0-2
    }
    else if ( f->type == Flit::READ_REPLY || f->type == Flit::WRITE_REPLY) {
 #ifdef PFP_ROUTING_DEBUG
     	   if((cur!=dest) && ((out_vc < VCNUM) || (out_vc > 2*VCNUM-1)))cout << "routefunc polarfly+ id:" << f->pid << " vcerr:" << out_vc << endl;
 #endif
-    	   assert((cur==dest) || ((out_vc >= VCNUM) && (out_vc <= 2*VCNUM-1))); //pending or VC3-5
+       assert((cur==dest) || ((out_vc >= VCNUM) && (out_vc <= 2*VCNUM-1))); //pending or VC3-5
    }
    else {
        assert((out_vc >= 0) && (out_vc <= 2*VCNUM-1));
    }
     traffic_table[ r->GetID( )][out_port]++;
-    //cout << "traffic table node" <<  r->GetID( ) << " port" << out_port << " :" << traffic_table[ r->GetID( )][out_port] << endl;
     outputs->AddRange( out_port, out_vc, out_vc );
    }
 }
@@ -2742,10 +2838,13 @@ assert(out_port > -1);
 
 void InitializeRoutingMap( const Configuration & config )
 {
-  Hypercubeport = config.GetInt( "k" );
-  Polarflyport = config.GetInt( "n" );
+  Hypercubeport = PolarFlyPlusHypercubePorts( config );
+  Polarflyport = PolarFlyPlusPolarFlyPorts( config );
+  NumNIC = config.GetInt( "nic" );
+  make_order();
   gNumVCs = config.GetInt( "num_vcs" );
-
+  _threshold = config.GetInt("collective_threshold");
+  pfp_first_minimal = ( config.GetStr( "pfp_minimal_route" ) == "first" );
   //
   // traffic class partitions
   //
@@ -471,7 +471,7 @@ void EventRouter::_ArrivalArb( int output )
     _out_cred_buffer[output].pop( );
     
     assert( c->vc.size() == 1 );
-    int vc = *c->vc.begin();
+    int vc = c->vc.First();
 
     EventNextVCState::eNextVCState state = 
       _output_state[output]->GetState( vc );
@@ -46,12 +46,17 @@
 #include "allocator.hpp"
 #include "switch_monitor.hpp"
 #include "buffer_monitor.hpp"
+#include "event_trace.hpp"
 
-IQRouter::IQRouter( Configuration const & config, Module *parent, 
+template<int kInputs, int kOutputs, int kVCs>
+IQRouterImpl<kInputs, kOutputs, kVCs>::IQRouterImpl( Configuration const & config, Module *parent, 
 		    string const & name, int id, int inputs, int outputs )
-: Router( config, parent, name, id, inputs, outputs ), _active(false)
+: IQRouter( config, parent, name, id, inputs, outputs ), _active(false)
 {
   _vcs         = config.GetInt( "num_vcs" );
+  assert((!kInputs || (inputs == kInputs)) &&
+	 (!kOutputs || (outputs == kOutputs)) &&
+	 (!kVCs || (_vcs == kVCs)));
 
   _vc_busy_when_full = (config.GetInt("vc_busy_when_full") > 0);
   _vc_prioritize_empty = (config.GetInt("vc_prioritize_empty") > 0);
@@ -81,17 +86,17 @@ IQRouter::IQRouter( Configuration const & config, Module *parent,
   _rf = rf_iter->second;
 
   // Alloc VC's
-  _buf.resize(_inputs);
-  for ( int i = 0; i < _inputs; ++i ) {
+  IQPorts<kInputs, Buffer *>::Init(_buf, _Inputs(), NULL);
+  for ( int i = 0; i < _Inputs(); ++i ) {
     ostringstream module_name;
     module_name << "buf_" << i;
-    _buf[i] = new Buffer(config, _outputs, this, module_name.str( ) );
+    _buf[i] = new Buffer(config, _Outputs(), this, module_name.str( ) );
     module_name.str("");
   }
 
   // Alloc next VCs' buffer state
-  _next_buf.resize(_outputs);
-  for (int j = 0; j < _outputs; ++j) {
+  IQPorts<kOutputs, BufferState *>::Init(_next_buf, _Outputs(), NULL);
+  for (int j = 0; j < _Outputs(); ++j) {
     ostringstream module_name;
     module_name << "next_vc_o" << j;
     _next_buf[j] = new BufferState( config, this, module_name.str( ) );
@@ -105,12 +110,12 @@ IQRouter::IQRouter( Configuration const & config, Module *parent,
       Error("Piggyback VC allocation requires speculative switch allocation to be enabled.");
     }
     _vc_allocator = NULL;
-    _vc_rr_offset.resize(_outputs*_classes, -1);
+    _vc_rr_offset.resize(_Outputs()*_classes, -1);
   } else {
     _vc_allocator = Allocator::NewAllocator( this, "vc_allocator", 
 					     vc_alloc_type,
-					     _vcs*_inputs, 
-					     _vcs*_outputs );
+					     _VCs()*_Inputs(), 
+					     _VCs()*_Outputs() );
 
     if ( !_vc_allocator ) {
       Error("Unknown vc_allocator type: " + vc_alloc_type);
@@ -120,8 +125,8 @@ IQRouter::IQRouter( Configuration const & config, Module *parent,
   string sw_alloc_type = config.GetStr( "sw_allocator" );
   _sw_allocator = Allocator::NewAllocator( this, "sw_allocator",
 					   sw_alloc_type,
-					   _inputs*_input_speedup, 
-					   _outputs*_output_speedup );
+					   _Inputs()*_input_speedup, 
+					   _Outputs()*_output_speedup );
 
   if ( !_sw_allocator ) {
     Error("Unknown sw_allocator type: " + sw_alloc_type);
@@ -131,8 +136,8 @@ IQRouter::IQRouter( Configuration const & config, Module *parent,
   if ( _speculative && ( spec_sw_alloc_type != "prio" ) ) {
     _spec_sw_allocator = Allocator::NewAllocator( this, "spec_sw_allocator",
 						  spec_sw_alloc_type,
-						  _inputs*_input_speedup, 
-						  _outputs*_output_speedup );
+						  _Inputs()*_input_speedup, 
+						  _Outputs()*_output_speedup );
     if ( !_spec_sw_allocator ) {
       Error("Unknown spec_sw_allocator type: " + spec_sw_alloc_type);
     }
@@ -140,8 +145,8 @@ IQRouter::IQRouter( Configuration const & config, Module *parent,
     _spec_sw_allocator = NULL;
   }
 
-  _sw_rr_offset.resize(_inputs*_input_speedup);
-  for(int i = 0; i < _inputs*_input_speedup; ++i)
+  _sw_rr_offset.resize(_Inputs()*_input_speedup);
+  for(int i = 0; i < _Inputs()*_input_speedup; ++i)
     _sw_rr_offset[i] = i % _input_speedup;
   
   _noq = config.GetInt("noq") > 0;
@@ -149,38 +154,52 @@ IQRouter::IQRouter( Configuration const & config, Module *parent,
     if(_routing_delay) {
       Error("NOQ requires lookahead routing to be enabled.");
     }
-    if(_vcs < _outputs) {
+    if(_VCs() < _Outputs()) {
       Error("NOQ requires at least as many VCs as router outputs.");
     }
   }
-  _noq_next_output_port.resize(_inputs, vector<int>(_vcs, -1));
-  _noq_next_vc_start.resize(_inputs, vector<int>(_vcs, -1));
-  _noq_next_vc_end.resize(_inputs, vector<int>(_vcs, -1));
+  _noq_next_output_port.resize(_Inputs(), vector<int>(_VCs(), -1));
+  _noq_next_vc_start.resize(_Inputs(), vector<int>(_VCs(), -1));
+  _noq_next_vc_end.resize(_Inputs(), vector<int>(_VCs(), -1));
+
+  // Pipeline stage queues
+  IQPorts<kInputs, Flit *>::Init(_in_queue_flits, _Inputs(), NULL);
+  _in_queue_count = 0;
+  IQPorts<kInputs, Credit *>::Init(_out_queue_credits, _Inputs(), NULL);
+  _out_queue_count = 0;
+  _proc_credits.reserve(_Outputs() * (_credit_delay + 1));
+  _route_vcs.reserve(_Inputs() * _VCs());
+  _vc_alloc_vcs.reserve(_Inputs() * _VCs());
+  _sw_hold_vcs.reserve(_Inputs() * _VCs());
+  _sw_alloc_vcs.reserve(_Inputs() * _VCs());
+  _crossbar_flits.reserve(_Outputs() * _output_speedup * (_crossbar_delay + 1));
 
   // Output queues
   _output_buffer_size = config.GetInt("output_buffer_size");
-  _output_buffer.resize(_outputs); 
-  _credit_buffer.resize(_inputs); 
+  IQPorts<kOutputs, queue<Flit *> >::Init(_output_buffer, _Outputs(), queue<Flit *>());
+  IQPorts<kInputs, queue<Credit *> >::Init(_credit_buffer, _Inputs(), queue<Credit *>());
 
   // Switch configuration (when held for multiple cycles)
   _hold_switch_for_packet = (config.GetInt("hold_switch_for_packet") > 0);
-  _switch_hold_in.resize(_inputs*_input_speedup, -1);
-  _switch_hold_out.resize(_outputs*_output_speedup, -1);
-  _switch_hold_vc.resize(_inputs*_input_speedup, -1);
+  _switch_hold_in.resize(_Inputs()*_input_speedup, -1);
+  _switch_hold_out.resize(_Outputs()*_output_speedup, -1);
+  _switch_hold_vc.resize(_Inputs()*_input_speedup, -1);
+  _train_free_in.resize(_Inputs()*_input_speedup, 0);
 
   _bufferMonitor = new BufferMonitor(inputs, _classes);
   _switchMonitor = new SwitchMonitor(inputs, outputs, _classes);
 
 #ifdef TRACK_FLOWS
   for(int c = 0; c < _classes; ++c) {
-    _stored_flits[c].resize(_inputs, 0);
-    _active_packets[c].resize(_inputs, 0);
+    _stored_flits[c].resize(_Inputs(), 0);
+    _active_packets[c].resize(_Inputs(), 0);
   }
-  _outstanding_classes.resize(_outputs, vector<queue<int> >(_vcs));
+  _outstanding_classes.resize(_Outputs(), vector<queue<int> >(_VCs()));
 #endif
 }
 
-IQRouter::~IQRouter( )
+template<int kInputs, int kOutputs, int kVCs>
+IQRouterImpl<kInputs, kOutputs, kVCs>::~IQRouterImpl( )
 {
 
   if(gPrintActivity) {
@@ -188,15 +207,15 @@ IQRouter::~IQRouter( )
     cout << *_bufferMonitor << endl ;
     
     cout << Name() << ".switchMonitor:" << endl ; 
-    cout << "Inputs=" << _inputs ;
-    cout << "Outputs=" << _outputs ;
+    cout << "Inputs=" << _Inputs() ;
+    cout << "Outputs=" << _Outputs() ;
     cout << *_switchMonitor << endl ;
   }
 
-  for(int i = 0; i < _inputs; ++i)
+  for(int i = 0; i < _Inputs(); ++i)
     delete _buf[i];
   
-  for(int j = 0; j < _outputs; ++j)
+  for(int j = 0; j < _Outputs(); ++j)
     delete _next_buf[j];
 
   delete _vc_allocator;
@@ -208,7 +227,8 @@ IQRouter::~IQRouter( )
   delete _switchMonitor;
 }
   
-void IQRouter::AddOutputChannel(FlitChannel * channel, CreditChannel * backchannel)
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::AddOutputChannel(FlitChannel * channel, CreditChannel * backchannel)
 {
   int alloc_delay = _speculative ? max(_vc_alloc_delay, _sw_alloc_delay) : (_vc_alloc_delay + _sw_alloc_delay);
   int min_latency = 1 + _crossbar_delay + channel->GetLatency() + _routing_delay + alloc_delay + backchannel->GetLatency()  + _credit_delay;
@@ -216,14 +236,16 @@ void IQRouter::AddOutputChannel(FlitChannel * channel, CreditChannel * backchann
   Router::AddOutputChannel(channel, backchannel);
 }
 
-void IQRouter::ReadInputs( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::ReadInputs( )
 {
   bool have_flits = _ReceiveFlits( );
   bool have_credits = _ReceiveCredits( );
   _active = _active || have_flits || have_credits;
 }
 
-void IQRouter::_InternalStep( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_InternalStep( )
 {
   if(!_active) {
     return;
@@ -282,21 +304,44 @@ void IQRouter::_InternalStep( )
   _switchMonitor->cycle( );
 }
 
-void IQRouter::WriteOutputs( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::WriteOutputs( )
 {
   _SendFlits( );
   _SendCredits( );
 }
 
+template<int kInputs, int kOutputs, int kVCs>
+bool IQRouterImpl<kInputs, kOutputs, kVCs>::IsIdle( ) const
+{
+  // a fractional speedup advances _partial_internal_cycles every cycle
+  if ( _active || _in_queue_count || _out_queue_count ||
+       ( _internal_speedup != (int)_internal_speedup ) ) {
+    return false;
+  }
+  for ( int output = 0; output < _Outputs(); ++output ) {
+    if ( !_output_buffer[output].empty( ) ) {
+      return false;
+    }
+  }
+  for ( int input = 0; input < _Inputs(); ++input ) {
+    if ( !_credit_buffer[input].empty( ) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
 
 //------------------------------------------------------------------------------
 // read inputs
 //------------------------------------------------------------------------------
 
-bool IQRouter::_ReceiveFlits( )
+template<int kInputs, int kOutputs, int kVCs>
+bool IQRouterImpl<kInputs, kOutputs, kVCs>::_ReceiveFlits( )
 {
   bool activity = false;
-  for(int input = 0; input < _inputs; ++input) { 
+  for(int input = 0; input < _Inputs(); ++input) { 
     Flit * const f = _input_channels[input]->Receive();
     if(f) {
 #ifdef PFP_ROUTER_DEBUG
@@ -312,17 +357,19 @@ bool IQRouter::_ReceiveFlits( )
 		   << " from channel at input " << input
 		   << "." << endl;
       }
-      _in_queue_flits.insert(make_pair(input, f));
+      _in_queue_flits[input] = f;
+      ++_in_queue_count;
       activity = true;
     }
   }
   return activity;
 }
 
-bool IQRouter::_ReceiveCredits( )
+template<int kInputs, int kOutputs, int kVCs>
+bool IQRouterImpl<kInputs, kOutputs, kVCs>::_ReceiveCredits( )
 {
   bool activity = false;
-  for(int output = 0; output < _outputs; ++output) {  
+  for(int output = 0; output < _Outputs(); ++output) {  
     Credit * const c = _output_credits[output]->Receive();
     if(c) {
       _proc_credits.push_back(make_pair(GetSimTime() + _credit_delay, 
@@ -338,20 +385,20 @@ bool IQRouter::_ReceiveCredits( )
 // input queuing
 //------------------------------------------------------------------------------
 
-void IQRouter::_InputQueuing( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_InputQueuing( )
 {
-  for(map<int, Flit *>::const_iterator iter = _in_queue_flits.begin();
-      iter != _in_queue_flits.end();
-      ++iter) {
+  for(int input = 0; (input < _Inputs()) && _in_queue_count; ++input) {
 
-    int const input = iter->first;
-    assert((input >= 0) && (input < _inputs));
-
-    Flit * const f = iter->second;
-    assert(f);
+    Flit * const f = _in_queue_flits[input];
+    if(!f) {
+      continue;
+    }
+    _in_queue_flits[input] = NULL;
+    --_in_queue_count;
 
     int const vc = f->vc;
-    assert((vc >= 0) && (vc < _vcs));
+    assert((vc >= 0) && (vc < _VCs()));
 
     Buffer * const cur_buf = _buf[input];
 
@@ -370,6 +417,9 @@ void IQRouter::_InputQueuing( )
       *gWatchOut << ")." << endl;
     }
     cur_buf->AddFlit(vc, f);
+    if(gEventTrace) {
+      gEventTrace->Record(EventTrace::arrive, _id, input, f);
+    }
 
 #ifdef TRACK_FLOWS
     ++_stored_flits[f->cl][input];
@@ -396,6 +446,9 @@ void IQRouter::_InputQueuing( )
 	}
 	cur_buf->SetRouteSet(vc, &f->la_route_set);
 	cur_buf->SetState(vc, VC::vc_alloc);
+	if(gEventTrace) {
+	  gEventTrace->Record(EventTrace::route, _id, input, f);
+	}
 	if(_speculative) {
 	  _sw_alloc_vcs.push_back(make_pair(-1, make_pair(make_pair(input, vc),
 							  -1)));
@@ -419,11 +472,10 @@ void IQRouter::_InputQueuing( )
       }
     }
   }
-  _in_queue_flits.clear();
 
   while(!_proc_credits.empty()) {
 
-    pair<int, pair<Credit *, int> > const & item = _proc_credits.front();
+    pair<int, pair<Credit *, int> > const item = _proc_credits.front();
 
     int const time = item.first;
     if(GetSimTime() < time) {
@@ -434,13 +486,12 @@ void IQRouter::_InputQueuing( )
     assert(c);
 
     int const output = item.second.second;
-    assert((output >= 0) && (output < _outputs));
+    assert((output >= 0) && (output < _Outputs()));
     
     BufferState * const dest_buf = _next_buf[output];
     
 #ifdef TRACK_FLOWS
-    for(set<int>::const_iterator iter = c->vc.begin(); iter != c->vc.end(); ++iter) {
-      int const vc = *iter;
+    for(int vc = c->vc.First(); vc >= 0; vc = c->vc.Next(vc)) {
       assert(!_outstanding_classes[output][vc].empty());
       int cl = _outstanding_classes[output][vc].front();
       _outstanding_classes[output][vc].pop();
@@ -460,11 +511,12 @@ void IQRouter::_InputQueuing( )
 // routing
 //------------------------------------------------------------------------------
 
-void IQRouter::_RouteEvaluate( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_RouteEvaluate( )
 {
   assert(_routing_delay);
 
-  for(deque<pair<int, pair<int, int> > >::iterator iter = _route_vcs.begin();
+  for(RingBuffer<pair<int, pair<int, int> > >::iterator iter = _route_vcs.begin();
       iter != _route_vcs.end();
       ++iter) {
     
@@ -475,9 +527,9 @@ void IQRouter::_RouteEvaluate( )
     iter->first = GetSimTime() + _routing_delay - 1;
     
     int const input = iter->second.first;
-    assert((input >= 0) && (input < _inputs));
+    assert((input >= 0) && (input < _Inputs()));
     int const vc = iter->second.second;
-    assert((vc >= 0) && (vc < _vcs));
+    assert((vc >= 0) && (vc < _VCs()));
 
     Buffer const * const cur_buf = _buf[input];
     assert(!cur_buf->Empty(vc));
@@ -498,13 +550,14 @@ void IQRouter::_RouteEvaluate( )
   }    
 }
 
-void IQRouter::_RouteUpdate( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_RouteUpdate( )
 {
   assert(_routing_delay);
 
   while(!_route_vcs.empty()) {
 
-    pair<int, pair<int, int> > const & item = _route_vcs.front();
+    pair<int, pair<int, int> > const item = _route_vcs.front();
 
     int const time = item.first;
     if((time < 0) || (GetSimTime() < time)) {
@@ -513,9 +566,9 @@ void IQRouter::_RouteUpdate( )
     assert(GetSimTime() == time);
 
     int const input = item.second.first;
-    assert((input >= 0) && (input < _inputs));
+    assert((input >= 0) && (input < _Inputs()));
     int const vc = item.second.second;
-    assert((vc >= 0) && (vc < _vcs));
+    assert((vc >= 0) && (vc < _VCs()));
     
     Buffer * const cur_buf = _buf[input];
     assert(!cur_buf->Empty(vc));
@@ -536,6 +589,9 @@ void IQRouter::_RouteUpdate( )
 
     cur_buf->Route(vc, _rf, this, f, input);
     cur_buf->SetState(vc, VC::vc_alloc);
+    if(gEventTrace) {
+      gEventTrace->Record(EventTrace::route, _id, input, f);
+    }
     if(_speculative) {
       _sw_alloc_vcs.push_back(make_pair(-1, make_pair(item.second, -1)));
     }
@@ -552,13 +608,14 @@ void IQRouter::_RouteUpdate( )
 // VC allocation
 //------------------------------------------------------------------------------
 
-void IQRouter::_VCAllocEvaluate( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_VCAllocEvaluate( )
 {
   assert(_vc_allocator);
 
   bool watched = false;
 
-  for(deque<pair<int, pair<pair<int, int>, int> > >::iterator iter = _vc_alloc_vcs.begin();
+  for(RingBuffer<pair<int, pair<pair<int, int>, int> > >::iterator iter = _vc_alloc_vcs.begin();
       iter != _vc_alloc_vcs.end();
       ++iter) {
 
@@ -568,9 +625,9 @@ void IQRouter::_VCAllocEvaluate( )
     }
 
     int const input = iter->second.first.first;
-    assert((input >= 0) && (input < _inputs));
+    assert((input >= 0) && (input < _Inputs()));
     int const vc = iter->second.first.second;
-    assert((vc >= 0) && (vc < _vcs));
+    assert((vc >= 0) && (vc < _VCs()));
 
     assert(iter->second.second == -1);
 
@@ -595,7 +652,7 @@ void IQRouter::_VCAllocEvaluate( )
     assert(route_set);
 
     int const out_priority = cur_buf->GetPriority(vc);
-    set<OutputSet::sSetElement> const setlist = route_set->GetSet();
+    OutputSet const & setlist = route_set->GetSet();
 
     bool elig = false;
     bool cred = false;
@@ -603,12 +660,12 @@ void IQRouter::_VCAllocEvaluate( )
 
     assert(!_noq || (setlist.size() == 1));
 
-    for(set<OutputSet::sSetElement>::const_iterator iset = setlist.begin();
+    for(OutputSet::const_iterator iset = setlist.begin();
 	iset != setlist.end();
 	++iset) {
 
       int const out_port = iset->output_port;
-      assert((out_port >= 0) && (out_port < _outputs));
+      assert((out_port >= 0) && (out_port < _Outputs()));
 
       BufferState const * const dest_buf = _next_buf[out_port];
 
@@ -623,12 +680,12 @@ void IQRouter::_VCAllocEvaluate( )
 	vc_start = iset->vc_start;
 	vc_end = iset->vc_end;
       }
-      assert(vc_start >= 0 && vc_start < _vcs);
-      assert(vc_end >= 0 && vc_end < _vcs);
+      assert(vc_start >= 0 && vc_start < _VCs());
+      assert(vc_end >= 0 && vc_end < _VCs());
       assert(vc_end >= vc_start);
 
       for(int out_vc = vc_start; out_vc <= vc_end; ++out_vc) {
-	assert((out_vc >= 0) && (out_vc < _vcs));
+	assert((out_vc >= 0) && (out_vc < _VCs()));
 
 	int in_priority = iset->pri;
 	if(_vc_prioritize_empty && !dest_buf->IsEmptyFor(out_vc)) {
@@ -645,8 +702,8 @@ void IQRouter::_VCAllocEvaluate( )
 	if(!dest_buf->IsAvailableFor(out_vc)) {
 	  if(f->watch) {
 	    int const use_input_and_vc = dest_buf->UsedBy(out_vc);
-	    int const use_input = use_input_and_vc / _vcs;
-	    int const use_vc = use_input_and_vc % _vcs;
+	    int const use_input = use_input_and_vc / _VCs();
+	    int const use_vc = use_input_and_vc % _VCs();
 	    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
 		       << "  VC " << out_vc 
 		       << " at output " << out_port 
@@ -681,8 +738,8 @@ void IQRouter::_VCAllocEvaluate( )
 	      watched = true;
 	    }
 	    int const input_and_vc
-	      = _vc_shuffle_requests ? (vc*_inputs + input) : (input*_vcs + vc);
-	    _vc_allocator->AddRequest(input_and_vc, out_port*_vcs + out_vc, 
+	      = _vc_shuffle_requests ? (vc*_Inputs() + input) : (input*_VCs() + vc);
+	    _vc_allocator->AddRequest(input_and_vc, out_port*_VCs() + out_vc, 
 				      0, in_priority, out_priority);
 	  }
 	}
@@ -707,7 +764,7 @@ void IQRouter::_VCAllocEvaluate( )
     _vc_allocator->PrintGrants( gWatchOut );
   }
 
-  for(deque<pair<int, pair<pair<int, int>, int> > >::iterator iter = _vc_alloc_vcs.begin();
+  for(RingBuffer<pair<int, pair<pair<int, int>, int> > >::iterator iter = _vc_alloc_vcs.begin();
       iter != _vc_alloc_vcs.end();
       ++iter) {
 
@@ -718,9 +775,9 @@ void IQRouter::_VCAllocEvaluate( )
     iter->first = GetSimTime() + _vc_alloc_delay - 1;
 
     int const input = iter->second.first.first;
-    assert((input >= 0) && (input < _inputs));
+    assert((input >= 0) && (input < _Inputs()));
     int const vc = iter->second.first.second;
-    assert((vc >= 0) && (vc < _vcs));
+    assert((vc >= 0) && (vc < _VCs()));
 
     if(iter->second.second < -1) {
       continue;
@@ -738,15 +795,15 @@ void IQRouter::_VCAllocEvaluate( )
     assert(f->head);
 
     int const input_and_vc
-      = _vc_shuffle_requests ? (vc*_inputs + input) : (input*_vcs + vc);
+      = _vc_shuffle_requests ? (vc*_Inputs() + input) : (input*_VCs() + vc);
     int const output_and_vc = _vc_allocator->OutputAssigned(input_and_vc);
 
     if(output_and_vc >= 0) {
 
-      int const match_output = output_and_vc / _vcs;
-      assert((match_output >= 0) && (match_output < _outputs));
-      int const match_vc = output_and_vc % _vcs;
-      assert((match_vc >= 0) && (match_vc < _vcs));
+      int const match_output = output_and_vc / _VCs();
+      assert((match_output >= 0) && (match_output < _Outputs()));
+      int const match_vc = output_and_vc % _VCs();
+      assert((match_vc >= 0) && (match_vc < _VCs()));
 
       if(f->watch) {
 	*gWatchOut << GetSimTime() << " | " << FullName() << " | "
@@ -777,7 +834,7 @@ void IQRouter::_VCAllocEvaluate( )
     return;
   }
 
-  for(deque<pair<int, pair<pair<int, int>, int> > >::iterator iter = _vc_alloc_vcs.begin();
+  for(RingBuffer<pair<int, pair<pair<int, int>, int> > >::iterator iter = _vc_alloc_vcs.begin();
       iter != _vc_alloc_vcs.end();
       ++iter) {
     
@@ -793,17 +850,17 @@ void IQRouter::_VCAllocEvaluate( )
     
     if(output_and_vc >= 0) {
       
-      int const match_output = output_and_vc / _vcs;
-      assert((match_output >= 0) && (match_output < _outputs));
-      int const match_vc = output_and_vc % _vcs;
-      assert((match_vc >= 0) && (match_vc < _vcs));
+      int const match_output = output_and_vc / _VCs();
+      assert((match_output >= 0) && (match_output < _Outputs()));
+      int const match_vc = output_and_vc % _VCs();
+      assert((match_vc >= 0) && (match_vc < _VCs()));
       
       BufferState const * const dest_buf = _next_buf[match_output];
       
       int const input = iter->second.first.first;
-      assert((input >= 0) && (input < _inputs));
+      assert((input >= 0) && (input < _Inputs()));
       int const vc = iter->second.first.second;
-      assert((vc >= 0) && (vc < _vcs));
+      assert((vc >= 0) && (vc < _VCs()));
       
       Buffer const * const cur_buf = _buf[input];
       assert(!cur_buf->Empty(vc));
@@ -839,13 +896,14 @@ void IQRouter::_VCAllocEvaluate( )
   }
 }
 
-void IQRouter::_VCAllocUpdate( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_VCAllocUpdate( )
 {
   assert(_vc_allocator);
 
   while(!_vc_alloc_vcs.empty()) {
 
-    pair<int, pair<pair<int, int>, int> > const & item = _vc_alloc_vcs.front();
+    pair<int, pair<pair<int, int>, int> > const item = _vc_alloc_vcs.front();
 
     int const time = item.first;
     if((time < 0) || (GetSimTime() < time)) {
@@ -854,9 +912,9 @@ void IQRouter::_VCAllocUpdate( )
     assert(GetSimTime() == time);
 
     int const input = item.second.first.first;
-    assert((input >= 0) && (input < _inputs));
+    assert((input >= 0) && (input < _Inputs()));
     int const vc = item.second.first.second;
-    assert((vc >= 0) && (vc < _vcs));
+    assert((vc >= 0) && (vc < _VCs()));
     
     assert(item.second.second != -1);
 
@@ -881,10 +939,10 @@ void IQRouter::_VCAllocUpdate( )
     
     if(output_and_vc >= 0) {
       
-      int const match_output = output_and_vc / _vcs;
-      assert((match_output >= 0) && (match_output < _outputs));
-      int const match_vc = output_and_vc % _vcs;
-      assert((match_vc >= 0) && (match_vc < _vcs));
+      int const match_output = output_and_vc / _VCs();
+      assert((match_output >= 0) && (match_output < _Outputs()));
+      int const match_vc = output_and_vc % _VCs();
+      assert((match_vc >= 0) && (match_vc < _VCs()));
       
       if(f->watch) {
 	*gWatchOut << GetSimTime() << " | " << FullName() << " | "
@@ -896,7 +954,11 @@ void IQRouter::_VCAllocUpdate( )
       BufferState * const dest_buf = _next_buf[match_output];
       assert(dest_buf->IsAvailableFor(match_vc));
       
-      dest_buf->TakeBuffer(match_vc, input*_vcs + vc);
+      dest_buf->TakeBuffer(match_vc, input*_VCs() + vc);
+      if(gEventTrace) {
+	gEventTrace->Record(EventTrace::vc_grant, _id, match_output, match_vc,
+			    f->id, f->pid, input);
+      }
 	
       cur_buf->SetOutput(vc, match_output, match_vc);
       cur_buf->SetState(vc, VC::active);
@@ -930,11 +992,12 @@ void IQRouter::_VCAllocUpdate( )
 // switch holding
 //------------------------------------------------------------------------------
 
-void IQRouter::_SWHoldEvaluate( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_SWHoldEvaluate( )
 {
   assert(_hold_switch_for_packet);
 
-  for(deque<pair<int, pair<pair<int, int>, int> > >::iterator iter = _sw_hold_vcs.begin();
+  for(RingBuffer<pair<int, pair<pair<int, int>, int> > >::iterator iter = _sw_hold_vcs.begin();
       iter != _sw_hold_vcs.end();
       ++iter) {
     
@@ -945,9 +1008,9 @@ void IQRouter::_SWHoldEvaluate( )
     iter->first = GetSimTime();
     
     int const input = iter->second.first.first;
-    assert((input >= 0) && (input < _inputs));
+    assert((input >= 0) && (input < _Inputs()));
     int const vc = iter->second.first.second;
-    assert((vc >= 0) && (vc < _vcs));
+    assert((vc >= 0) && (vc < _VCs()));
     
     assert(iter->second.second == -1);
 
@@ -971,16 +1034,16 @@ void IQRouter::_SWHoldEvaluate( )
     assert(_switch_hold_vc[expanded_input] == vc);
     
     int const match_port = cur_buf->GetOutputPort(vc);
-    assert((match_port >= 0) && (match_port < _outputs));
+    assert((match_port >= 0) && (match_port < _Outputs()));
     int const match_vc = cur_buf->GetOutputVC(vc);
-    assert((match_vc >= 0) && (match_vc < _vcs));
+    assert((match_vc >= 0) && (match_vc < _VCs()));
     
     int const expanded_output = match_port*_output_speedup + input%_output_speedup;
     assert(_switch_hold_in[expanded_input] == expanded_output);
     
     BufferState const * const dest_buf = _next_buf[match_port];
     
-    if(dest_buf->IsFullFor(match_vc)) {
+    if(dest_buf->IsFullFor(match_vc, f)) {
       if(f->watch) {
 	*gWatchOut << GetSimTime() << " | " << FullName() << " | "
 		   << "  Unable to reuse held connection from input " << input
@@ -1004,13 +1067,14 @@ void IQRouter::_SWHoldEvaluate( )
   }
 }
 
-void IQRouter::_SWHoldUpdate( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_SWHoldUpdate( )
 {
   assert(_hold_switch_for_packet);
 
   while(!_sw_hold_vcs.empty()) {
     
-    pair<int, pair<pair<int, int>, int> > const & item = _sw_hold_vcs.front();
+    pair<int, pair<pair<int, int>, int> > const item = _sw_hold_vcs.front();
     
     int const time = item.first;
     if(time < 0) {
@@ -1019,9 +1083,9 @@ void IQRouter::_SWHoldUpdate( )
     assert(GetSimTime() == time);
     
     int const input = item.second.first.first;
-    assert((input >= 0) && (input < _inputs));
+    assert((input >= 0) && (input < _Inputs()));
     int const vc = item.second.first.second;
-    assert((vc >= 0) && (vc < _vcs));
+    assert((vc >= 0) && (vc < _VCs()));
     
     assert(item.second.second != -1);
 
@@ -1052,11 +1116,11 @@ void IQRouter::_SWHoldUpdate( )
       assert(_switch_hold_out[expanded_output] == expanded_input);
       
       int const output = expanded_output / _output_speedup;
-      assert((output >= 0) && (output < _outputs));
+      assert((output >= 0) && (output < _Outputs()));
       assert(cur_buf->GetOutputPort(vc) == output);
       
       int const match_vc = cur_buf->GetOutputVC(vc);
-      assert((match_vc >= 0) && (match_vc < _vcs));
+      assert((match_vc >= 0) && (match_vc < _VCs()));
       
       BufferState * const dest_buf = _next_buf[output];
       
@@ -1095,10 +1159,10 @@ void IQRouter::_SWHoldUpdate( )
 	    assert(next_output_port >= 0);
 	    _noq_next_output_port[input][vc] = -1;
 	    int next_vc_start = _noq_next_vc_start[input][vc];
-	    assert(next_vc_start >= 0 && next_vc_start < _vcs);
+	    assert(next_vc_start >= 0 && next_vc_start < _VCs());
 	    _noq_next_vc_start[input][vc] = -1;
 	    int next_vc_end = _noq_next_vc_end[input][vc];
-	    assert(next_vc_end >= 0 && next_vc_end < _vcs);
+	    assert(next_vc_end >= 0 && next_vc_end < _VCs());
 	    _noq_next_vc_end[input][vc] = -1;
 	    f->la_route_set.Clear();
 	    f->la_route_set.AddRange(next_output_port, next_vc_start, next_vc_end);
@@ -1125,10 +1189,20 @@ void IQRouter::_SWHoldUpdate( )
 
       _crossbar_flits.push_back(make_pair(-1, make_pair(f, make_pair(expanded_input, expanded_output))));
       
-      if(_out_queue_credits.count(input) == 0) {
-	_out_queue_credits.insert(make_pair(input, Credit::New()));
+      if(f->train > 1) {
+	// the credits of a train go back on their own
+	Credit * const c = Credit::New();
+	c->vc.insert(vc);
+	c->train = f->train;
+	_credit_buffer[input].push(c);
+      } else {
+	Credit * & c = _out_queue_credits[input];
+	if(!c) {
+	  c = Credit::New();
+	  ++_out_queue_count;
+	}
+	c->vc.insert(vc);
       }
-      _out_queue_credits.find(input)->second->vc.insert(vc);
       
       if(cur_buf->Empty(vc)) {
 	if(f->watch) {
@@ -1175,6 +1249,9 @@ void IQRouter::_SWHoldUpdate( )
 	    }
 	    cur_buf->SetRouteSet(vc, &nf->la_route_set);
 	    cur_buf->SetState(vc, VC::vc_alloc);
+	    if(gEventTrace) {
+	      gEventTrace->Record(EventTrace::route, _id, input, nf);
+	    }
 	    if(_speculative) {
 	      _sw_alloc_vcs.push_back(make_pair(-1, make_pair(item.second.first,
 							      -1)));
@@ -1223,11 +1300,12 @@ void IQRouter::_SWHoldUpdate( )
 // switch allocation
 //------------------------------------------------------------------------------
 
-bool IQRouter::_SWAllocAddReq(int input, int vc, int output)
+template<int kInputs, int kOutputs, int kVCs>
+bool IQRouterImpl<kInputs, kOutputs, kVCs>::_SWAllocAddReq(int input, int vc, int output)
 {
-  assert(input >= 0 && input < _inputs);
-  assert(vc >= 0 && vc < _vcs);
-  assert(output >= 0 && output < _outputs);
+  assert(input >= 0 && input < _Inputs());
+  assert(vc >= 0 && vc < _VCs());
+  assert(output >= 0 && output < _Outputs());
   
   // When input_speedup > 1, the virtual channel buffers are interleaved to 
   // create multiple input ports to the switch. Similarily, the output ports 
@@ -1244,6 +1322,18 @@ bool IQRouter::_SWAllocAddReq(int input, int vc, int output)
   Flit const * const f = cur_buf->FrontFlit(vc);
   assert(f);
   assert(f->vc == vc);
+
+  if(GetSimTime() < _train_free_in[expanded_input]) {
+    if(f->watch) {
+      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
+		 << "  Ignoring output " << output
+		 << "." << (expanded_output % _output_speedup)
+		 << " while input " << input
+		 << "." << (expanded_input % _input_speedup)
+		 << " sends a flit train." << endl;
+    }
+    return false;
+  }
   
   if((_switch_hold_in[expanded_input] < 0) && 
      (_switch_hold_out[expanded_output] < 0)) {
@@ -1264,7 +1354,7 @@ bool IQRouter::_SWAllocAddReq(int input, int vc, int output)
     
     if(allocator->ReadRequest(req, expanded_input, expanded_output)) {
       if(RoundRobinArbiter::Supersedes(vc, prio, req.label, req.in_pri, 
-				       _sw_rr_offset[expanded_input], _vcs)) {
+				       _sw_rr_offset[expanded_input], _VCs())) {
 	if(f->watch) {
 	  *gWatchOut << GetSimTime() << " | " << FullName() << " | "
 		     << "  Replacing earlier request from VC " << req.label
@@ -1326,11 +1416,12 @@ bool IQRouter::_SWAllocAddReq(int input, int vc, int output)
   return false;
 }
 
-void IQRouter::_SWAllocEvaluate( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_SWAllocEvaluate( )
 {
   bool watched = false;
 
-  for(deque<pair<int, pair<pair<int, int>, int> > >::iterator iter = _sw_alloc_vcs.begin();
+  for(RingBuffer<pair<int, pair<pair<int, int>, int> > >::iterator iter = _sw_alloc_vcs.begin();
       iter != _sw_alloc_vcs.end();
       ++iter) {
 
@@ -1340,9 +1431,9 @@ void IQRouter::_SWAllocEvaluate( )
     }
 
     int const input = iter->second.first.first;
-    assert((input >= 0) && (input < _inputs));
+    assert((input >= 0) && (input < _Inputs()));
     int const vc = iter->second.first.second;
-    assert((vc >= 0) && (vc < _vcs));
+    assert((vc >= 0) && (vc < _VCs()));
     
     assert(iter->second.second == -1);
 
@@ -1368,13 +1459,13 @@ void IQRouter::_SWAllocEvaluate( )
     if(cur_buf->GetState(vc) == VC::active) {
       
       int const dest_output = cur_buf->GetOutputPort(vc);
-      assert((dest_output >= 0) && (dest_output < _outputs));
+      assert((dest_output >= 0) && (dest_output < _Outputs()));
       int const dest_vc = cur_buf->GetOutputVC(vc);
-      assert((dest_vc >= 0) && (dest_vc < _vcs));
+      assert((dest_vc >= 0) && (dest_vc < _VCs()));
       
       BufferState const * const dest_buf = _next_buf[dest_output];
       
-      if(dest_buf->IsFullFor(dest_vc) || ( _output_buffer_size!=-1  && _output_buffer[dest_output].size()>=(size_t)(_output_buffer_size))) {
+      if(dest_buf->IsFullFor(dest_vc, f) || ( _output_buffer_size!=-1  && _output_buffer[dest_output].size()>=(size_t)(_output_buffer_size))) {
 	if(f->watch) {
 	  *gWatchOut << GetSimTime() << " | " << FullName() << " | "
 		     << "  VC " << dest_vc 
@@ -1399,16 +1490,16 @@ void IQRouter::_SWAllocEvaluate( )
     OutputSet const * const route_set = cur_buf->GetRouteSet(vc);
     assert(route_set);
     
-    set<OutputSet::sSetElement> const setlist = route_set->GetSet();
+    OutputSet const & setlist = route_set->GetSet();
     
     assert(!_noq || (setlist.size() == 1));
 
-    for(set<OutputSet::sSetElement>::const_iterator iset = setlist.begin();
+    for(OutputSet::const_iterator iset = setlist.begin();
 	iset != setlist.end();
 	++iset) {
       
       int const dest_output = iset->output_port;
-      assert((dest_output >= 0) && (dest_output < _outputs));
+      assert((dest_output >= 0) && (dest_output < _Outputs()));
       
       // for lower levels of speculation, ignore credit availability and always 
       // issue requests for all output ports in route set
@@ -1434,12 +1525,12 @@ void IQRouter::_SWAllocEvaluate( )
 	  vc_start = iset->vc_start;
 	  vc_end = iset->vc_end;
 	}
-	assert(vc_start >= 0 && vc_start < _vcs);
-	assert(vc_end >= 0 && vc_end < _vcs);
+	assert(vc_start >= 0 && vc_start < _VCs());
+	assert(vc_end >= 0 && vc_end < _VCs());
 	assert(vc_end >= vc_start);
 	
 	for(int dest_vc = vc_start; dest_vc <= vc_end; ++dest_vc) {
-	  assert((dest_vc >= 0) && (dest_vc < _vcs));
+	  assert((dest_vc >= 0) && (dest_vc < _VCs()));
 	  
 	  if(dest_buf->IsAvailableFor(dest_vc) && ( _output_buffer_size==-1 || _output_buffer[dest_output].size()<(size_t)(_output_buffer_size))) {
 	    elig = true;
@@ -1494,7 +1585,7 @@ void IQRouter::_SWAllocEvaluate( )
     }
   }
   
-  for(deque<pair<int, pair<pair<int, int>, int> > >::iterator iter = _sw_alloc_vcs.begin();
+  for(RingBuffer<pair<int, pair<pair<int, int>, int> > >::iterator iter = _sw_alloc_vcs.begin();
       iter != _sw_alloc_vcs.end();
       ++iter) {
 
@@ -1505,9 +1596,9 @@ void IQRouter::_SWAllocEvaluate( )
     iter->first = GetSimTime() + _sw_alloc_delay - 1;
 
     int const input = iter->second.first.first;
-    assert((input >= 0) && (input < _inputs));
+    assert((input >= 0) && (input < _Inputs()));
     int const vc = iter->second.first.second;
-    assert((vc >= 0) && (vc < _vcs));
+    assert((vc >= 0) && (vc < _VCs()));
 
     if(iter->second.second < -1) {
       continue;
@@ -1541,7 +1632,7 @@ void IQRouter::_SWAllocEvaluate( )
 		     << "." << (vc % _input_speedup)
 		     << "." << endl;
 	}
-	_sw_rr_offset[expanded_input] = (vc + _input_speedup) % _vcs;
+	_sw_rr_offset[expanded_input] = (vc + _input_speedup) % _VCs();
 	iter->second.second = expanded_output;
       } else {
 	if(f->watch) {
@@ -1593,7 +1684,7 @@ void IQRouter::_SWAllocEvaluate( )
 			 << "." << (vc % _input_speedup)
 			 << "." << endl;
 	    }
-	    _sw_rr_offset[expanded_input] = (vc + _input_speedup) % _vcs;
+	    _sw_rr_offset[expanded_input] = (vc + _input_speedup) % _VCs();
 	    iter->second.second = expanded_output;
 	  } else {
 	    if(f->watch) {
@@ -1635,7 +1726,7 @@ void IQRouter::_SWAllocEvaluate( )
     return;
   }
 
-  for(deque<pair<int, pair<pair<int, int>, int> > >::iterator iter = _sw_alloc_vcs.begin();
+  for(RingBuffer<pair<int, pair<pair<int, int>, int> > >::iterator iter = _sw_alloc_vcs.begin();
       iter != _sw_alloc_vcs.end();
       ++iter) {
 
@@ -1652,15 +1743,15 @@ void IQRouter::_SWAllocEvaluate( )
     if(expanded_output >= 0) {
       
       int const output = expanded_output / _output_speedup;
-      assert((output >= 0) && (output < _outputs));
+      assert((output >= 0) && (output < _Outputs()));
       
       BufferState const * const dest_buf = _next_buf[output];
       
       int const input = iter->second.first.first;
-      assert((input >= 0) && (input < _inputs));
+      assert((input >= 0) && (input < _Inputs()));
       assert((input % _output_speedup) == (expanded_output % _output_speedup));
       int const vc = iter->second.first.second;
-      assert((vc >= 0) && (vc < _vcs));
+      assert((vc >= 0) && (vc < _VCs()));
       
       int const expanded_input = input * _input_speedup + vc % _input_speedup;
       assert(_switch_hold_vc[expanded_input] != vc);
@@ -1703,7 +1794,7 @@ void IQRouter::_SWAllocEvaluate( )
 	if(_vc_allocator) { // separate VC and switch allocators
 
 	  int const input_and_vc = 
-	    _vc_shuffle_requests ? (vc*_inputs + input) : (input*_vcs + vc);
+	    _vc_shuffle_requests ? (vc*_Inputs() + input) : (input*_VCs() + vc);
 	  int const output_and_vc = _vc_allocator->OutputAssigned(input_and_vc);
 
 	  if(output_and_vc < 0) {
@@ -1716,7 +1807,7 @@ void IQRouter::_SWAllocEvaluate( )
 			 << " due to misspeculation." << endl;
 	    }
 	    iter->second.second = -1; // stall is counted in VC allocation path!
-	  } else if((output_and_vc / _vcs) != output) {
+	  } else if((output_and_vc / _VCs()) != output) {
 	    if(f->watch) {
 	      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
 			 << "Discarding grant from input " << input
@@ -1726,7 +1817,7 @@ void IQRouter::_SWAllocEvaluate( )
 			 << " due to port mismatch between VC and switch allocator." << endl;
 	    }
 	    iter->second.second = STALL_BUFFER_CONFLICT; // count this case as if we had failed allocation
-	  } else if(dest_buf->IsFullFor((output_and_vc % _vcs))) {
+	  } else if(dest_buf->IsFullFor((output_and_vc % _VCs()), f)) {
 	    if(f->watch) {
 	      *gWatchOut << GetSimTime() << " | " << FullName() << " | "
 			 << "Discarding grant from input " << input
@@ -1743,7 +1834,7 @@ void IQRouter::_SWAllocEvaluate( )
 	  OutputSet const * const route_set = cur_buf->GetRouteSet(vc);
 	  assert(route_set);
 
-	  set<OutputSet::sSetElement> const setlist = route_set->GetSet();
+	  OutputSet const & setlist = route_set->GetSet();
 
 	  bool busy = true;
 	  bool full = true;
@@ -1751,7 +1842,7 @@ void IQRouter::_SWAllocEvaluate( )
 
 	  assert(!_noq || (setlist.size() == 1));
 
-	  for(set<OutputSet::sSetElement>::const_iterator iset = setlist.begin();
+	  for(OutputSet::const_iterator iset = setlist.begin();
 	      iset != setlist.end();
 	      ++iset) {
 	    if(iset->output_port == output) {
@@ -1767,12 +1858,12 @@ void IQRouter::_SWAllocEvaluate( )
 		vc_start = iset->vc_start;
 		vc_end = iset->vc_end;
 	      }
-	      assert(vc_start >= 0 && vc_start < _vcs);
-	      assert(vc_end >= 0 && vc_end < _vcs);
+	      assert(vc_start >= 0 && vc_start < _VCs());
+	      assert(vc_end >= 0 && vc_end < _VCs());
 	      assert(vc_end >= vc_start);
 	      
 	      for(int out_vc = vc_start; out_vc <= vc_end; ++out_vc) {
-		assert((out_vc >= 0) && (out_vc < _vcs));
+		assert((out_vc >= 0) && (out_vc < _VCs()));
 		if(dest_buf->IsAvailableFor(out_vc)) {
 		  busy = false;
 		  if(!dest_buf->IsFullFor(out_vc)) {
@@ -1817,9 +1908,9 @@ void IQRouter::_SWAllocEvaluate( )
 	assert(cur_buf->GetOutputPort(vc) == output);
 	
 	int const match_vc = cur_buf->GetOutputVC(vc);
-	assert((match_vc >= 0) && (match_vc < _vcs));
+	assert((match_vc >= 0) && (match_vc < _VCs()));
 
-	if(dest_buf->IsFullFor(match_vc)) {
+	if(dest_buf->IsFullFor(match_vc, f)) {
 	  if(f->watch) {
 	    *gWatchOut << GetSimTime() << " | " << FullName() << " | "
 		       << "  Discarding grant from input " << input
@@ -1835,11 +1926,12 @@ void IQRouter::_SWAllocEvaluate( )
   }
 }
 
-void IQRouter::_SWAllocUpdate( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_SWAllocUpdate( )
 {
   while(!_sw_alloc_vcs.empty()) {
 
-    pair<int, pair<pair<int, int>, int> > const & item = _sw_alloc_vcs.front();
+    pair<int, pair<pair<int, int>, int> > const item = _sw_alloc_vcs.front();
 
     int const time = item.first;
     if((time < 0) || (GetSimTime() < time)) {
@@ -1848,9 +1940,9 @@ void IQRouter::_SWAllocUpdate( )
     assert(GetSimTime() == time);
 
     int const input = item.second.first.first;
-    assert((input >= 0) && (input < _inputs));
+    assert((input >= 0) && (input < _Inputs()));
     int const vc = item.second.first.second;
-    assert((vc >= 0) && (vc < _vcs));
+    assert((vc >= 0) && (vc < _VCs()));
     
     Buffer * const cur_buf = _buf[input];
     assert(!cur_buf->Empty(vc));
@@ -1879,7 +1971,7 @@ void IQRouter::_SWAllocUpdate( )
       assert(_switch_hold_out[expanded_output] < 0);
 
       int const output = expanded_output / _output_speedup;
-      assert((output >= 0) && (output < _outputs));
+      assert((output >= 0) && (output < _Outputs()));
 
       BufferState * const dest_buf = _next_buf[output];
 
@@ -1898,11 +1990,11 @@ void IQRouter::_SWAllocUpdate( )
 	int match_prio = numeric_limits<int>::min();
 
 	const OutputSet * route_set = cur_buf->GetRouteSet(vc);
-	set<OutputSet::sSetElement> const setlist = route_set->GetSet();
+	OutputSet const & setlist = route_set->GetSet();
 	
 	assert(!_noq || (setlist.size() == 1));
 	
-	for(set<OutputSet::sSetElement>::const_iterator iset = setlist.begin();
+	for(OutputSet::const_iterator iset = setlist.begin();
 	    iset != setlist.end();
 	    ++iset) {
 	  if(iset->output_port == output) {
@@ -1918,12 +2010,12 @@ void IQRouter::_SWAllocUpdate( )
 	      vc_start = iset->vc_start;
 	      vc_end = iset->vc_end;
 	    }
-	    assert(vc_start >= 0 && vc_start < _vcs);
-	    assert(vc_end >= 0 && vc_end < _vcs);
+	    assert(vc_start >= 0 && vc_start < _VCs());
+	    assert(vc_end >= 0 && vc_end < _VCs());
 	    assert(vc_end >= vc_start);
 
 	    for(int out_vc = vc_start; out_vc <= vc_end; ++out_vc) {
-	      assert((out_vc >= 0) && (out_vc < _vcs));
+	      assert((out_vc >= 0) && (out_vc < _VCs()));
 	      
 	      int vc_prio = iset->pri;
 	      if(_vc_prioritize_empty && !dest_buf->IsEmptyFor(out_vc)) {
@@ -1939,7 +2031,7 @@ void IQRouter::_SWAllocUpdate( )
 		 ((match_vc < 0) || 
 		  RoundRobinArbiter::Supersedes(out_vc, vc_prio, 
 						match_vc, match_prio, 
-						vc_offset, _vcs))) {
+						vc_offset, _VCs()))) {
 		match_vc = out_vc;
 		match_prio = vc_prio;
 	      }
@@ -1957,9 +2049,9 @@ void IQRouter::_SWAllocUpdate( )
 
 	cur_buf->SetState(vc, VC::active);
 	cur_buf->SetOutput(vc, output, match_vc);
-	dest_buf->TakeBuffer(match_vc, input*_vcs + vc);
+	dest_buf->TakeBuffer(match_vc, input*_VCs() + vc);
 
-	_vc_rr_offset[output*_classes+cl] = (match_vc + 1) % _vcs;
+	_vc_rr_offset[output*_classes+cl] = (match_vc + 1) % _VCs();
 
       } else {
 
@@ -1968,7 +2060,7 @@ void IQRouter::_SWAllocUpdate( )
 	match_vc = cur_buf->GetOutputVC(vc);
 
       }
-      assert((match_vc >= 0) && (match_vc < _vcs));
+      assert((match_vc >= 0) && (match_vc < _VCs()));
 
       if(f->watch) {
 	*gWatchOut << GetSimTime() << " | " << FullName() << " | "
@@ -2005,10 +2097,10 @@ void IQRouter::_SWAllocUpdate( )
 	    assert(next_output_port >= 0);
 	    _noq_next_output_port[input][vc] = -1;
 	    int next_vc_start = _noq_next_vc_start[input][vc];
-	    assert(next_vc_start >= 0 && next_vc_start < _vcs);
+	    assert(next_vc_start >= 0 && next_vc_start < _VCs());
 	    _noq_next_vc_start[input][vc] = -1;
 	    int next_vc_end = _noq_next_vc_end[input][vc];
-	    assert(next_vc_end >= 0 && next_vc_end < _vcs);
+	    assert(next_vc_end >= 0 && next_vc_end < _VCs());
 	    _noq_next_vc_end[input][vc] = -1;
 	    f->la_route_set.Clear();
 	    f->la_route_set.AddRange(next_output_port, next_vc_start, next_vc_end);
@@ -2035,10 +2127,22 @@ void IQRouter::_SWAllocUpdate( )
 
       _crossbar_flits.push_back(make_pair(-1, make_pair(f, make_pair(expanded_input, expanded_output))));
 
-      if(_out_queue_credits.count(input) == 0) {
-	_out_queue_credits.insert(make_pair(input, Credit::New()));
+      if(f->train > 1) {
+	// the credits of a train go back on their own, and the input reads
+	// out all of its flits before it bids for the switch again
+	Credit * const c = Credit::New();
+	c->vc.insert(vc);
+	c->train = f->train;
+	_credit_buffer[input].push(c);
+	_train_free_in[expanded_input] = GetSimTime() + f->train;
+      } else {
+	Credit * & c = _out_queue_credits[input];
+	if(!c) {
+	  c = Credit::New();
+	  ++_out_queue_count;
+	}
+	c->vc.insert(vc);
       }
-      _out_queue_credits.find(input)->second->vc.insert(vc);
 
       if(cur_buf->Empty(vc)) {
 	if(f->tail) {
@@ -2063,6 +2167,9 @@ void IQRouter::_SWAllocUpdate( )
 	    }
 	    cur_buf->SetRouteSet(vc, &nf->la_route_set);
 	    cur_buf->SetState(vc, VC::vc_alloc);
+	    if(gEventTrace) {
+	      gEventTrace->Record(EventTrace::route, _id, input, nf);
+	    }
 	    if(_speculative) {
 	      _sw_alloc_vcs.push_back(make_pair(-1, make_pair(item.second.first,
 							      -1)));
@@ -2134,9 +2241,10 @@ void IQRouter::_SWAllocUpdate( )
 // switch traversal
 //------------------------------------------------------------------------------
 
-void IQRouter::_SwitchEvaluate( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_SwitchEvaluate( )
 {
-  for(deque<pair<int, pair<Flit *, pair<int, int> > > >::iterator iter = _crossbar_flits.begin();
+  for(RingBuffer<pair<int, pair<Flit *, pair<int, int> > > >::iterator iter = _crossbar_flits.begin();
       iter != _crossbar_flits.end();
       ++iter) {
     
@@ -2164,11 +2272,12 @@ void IQRouter::_SwitchEvaluate( )
   }
 }
 
-void IQRouter::_SwitchUpdate( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_SwitchUpdate( )
 {
   while(!_crossbar_flits.empty()) {
 
-    pair<int, pair<Flit *, pair<int, int> > > const & item = _crossbar_flits.front();
+    pair<int, pair<Flit *, pair<int, int> > > const item = _crossbar_flits.front();
 
     int const time = item.first;
     if((time < 0) || (GetSimTime() < time)) {
@@ -2181,10 +2290,10 @@ void IQRouter::_SwitchUpdate( )
 
     int const expanded_input = item.second.second.first;
     int const input = expanded_input / _input_speedup;
-    assert((input >= 0) && (input < _inputs));
+    assert((input >= 0) && (input < _Inputs()));
     int const expanded_output = item.second.second.second;
     int const output = expanded_output / _output_speedup;
-    assert((output >= 0) && (output < _outputs));
+    assert((output >= 0) && (output < _Outputs()));
 
     if(f->watch) {
       *gWatchOut << GetSimTime() << " | " << FullName() << " | "
@@ -2196,6 +2305,9 @@ void IQRouter::_SwitchUpdate( )
 		 << "." << endl;
     }
     _switchMonitor->traversal(input, output, f) ;
+    if(gEventTrace) {
+      gEventTrace->Record(EventTrace::sw_traverse, _id, output, f, input);
+    }
 
     if(f->watch) {
       *gWatchOut << GetSimTime() << " | " << FullName() << " | "
@@ -2216,31 +2328,31 @@ void IQRouter::_SwitchUpdate( )
 // output queuing
 //------------------------------------------------------------------------------
 
-void IQRouter::_OutputQueuing( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_OutputQueuing( )
 {
-  for(map<int, Credit *>::const_iterator iter = _out_queue_credits.begin();
-      iter != _out_queue_credits.end();
-      ++iter) {
+  for(int input = 0; (input < _Inputs()) && _out_queue_count; ++input) {
 
-    int const input = iter->first;
-    assert((input >= 0) && (input < _inputs));
-
-    Credit * const c = iter->second;
-    assert(c);
+    Credit * const c = _out_queue_credits[input];
+    if(!c) {
+      continue;
+    }
     assert(!c->vc.empty());
 
     _credit_buffer[input].push(c);
+    _out_queue_credits[input] = NULL;
+    --_out_queue_count;
   }
-  _out_queue_credits.clear();
 }
 
 //------------------------------------------------------------------------------
 // write outputs
 //------------------------------------------------------------------------------
 
-void IQRouter::_SendFlits( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_SendFlits( )
 {
-  for ( int output = 0; output < _outputs; ++output ) {
+  for ( int output = 0; output < _Outputs(); ++output ) {
     if ( !_output_buffer[output].empty( ) ) {
       Flit * const f = _output_buffer[output].front( );
       assert(f);
@@ -2263,13 +2375,19 @@ void IQRouter::_SendFlits( )
   }
 }
 
-void IQRouter::_SendCredits( )
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_SendCredits( )
 {
-  for ( int input = 0; input < _inputs; ++input ) {
+  for ( int input = 0; input < _Inputs(); ++input ) {
     if ( !_credit_buffer[input].empty( ) ) {
       Credit * const c = _credit_buffer[input].front( );
       assert(c);
       _credit_buffer[input].pop( );
+      if(gEventTrace) {
+	for(int vc = c->vc.First(); vc >= 0; vc = c->vc.Next(vc)) {
+	  gEventTrace->Record(EventTrace::credit, _id, input, vc, -1, -1, -1);
+	}
+      }
       _input_credits[input]->Send( c );
     }
   }
@@ -2280,79 +2398,88 @@ void IQRouter::_SendCredits( )
 // misc.
 //------------------------------------------------------------------------------
 
-void IQRouter::Display( ostream & os ) const
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::Display( ostream & os ) const
 {
-  for ( int input = 0; input < _inputs; ++input ) {
+  for ( int input = 0; input < _Inputs(); ++input ) {
     _buf[input]->Display( os );
   }
 }
 
-int IQRouter::GetUsedCredit(int o) const
+template<int kInputs, int kOutputs, int kVCs>
+int IQRouterImpl<kInputs, kOutputs, kVCs>::GetUsedCredit(int o) const
 {
-  assert((o >= 0) && (o < _outputs));
+  assert((o >= 0) && (o < _Outputs()));
   BufferState const * const dest_buf = _next_buf[o];
   return dest_buf->Occupancy();
 }
 
-int IQRouter::GetBufferOccupancy(int i) const {
-  assert(i >= 0 && i < _inputs);
+template<int kInputs, int kOutputs, int kVCs>
+int IQRouterImpl<kInputs, kOutputs, kVCs>::GetBufferOccupancy(int i) const {
+  assert(i >= 0 && i < _Inputs());
   return _buf[i]->GetOccupancy();
 }
 
 #ifdef TRACK_BUFFERS
-int IQRouter::GetUsedCreditForClass(int output, int cl) const
+template<int kInputs, int kOutputs, int kVCs>
+int IQRouterImpl<kInputs, kOutputs, kVCs>::GetUsedCreditForClass(int output, int cl) const
 {
-  assert((output >= 0) && (output < _outputs));
+  assert((output >= 0) && (output < _Outputs()));
   BufferState const * const dest_buf = _next_buf[output];
   return dest_buf->OccupancyForClass(cl);
 }
 
-int IQRouter::GetBufferOccupancyForClass(int input, int cl) const
+template<int kInputs, int kOutputs, int kVCs>
+int IQRouterImpl<kInputs, kOutputs, kVCs>::GetBufferOccupancyForClass(int input, int cl) const
 {
-  assert((input >= 0) && (input < _inputs));
+  assert((input >= 0) && (input < _Inputs()));
   return _buf[input]->GetOccupancyForClass(cl);
 }
 #endif
 
-vector<int> IQRouter::UsedCredits() const
+template<int kInputs, int kOutputs, int kVCs>
+vector<int> IQRouterImpl<kInputs, kOutputs, kVCs>::UsedCredits() const
 {
-  vector<int> result(_outputs*_vcs);
-  for(int o = 0; o < _outputs; ++o) {
-    for(int v = 0; v < _vcs; ++v) {
-      result[o*_vcs+v] = _next_buf[o]->OccupancyFor(v);
+  vector<int> result(_Outputs()*_VCs());
+  for(int o = 0; o < _Outputs(); ++o) {
+    for(int v = 0; v < _VCs(); ++v) {
+      result[o*_VCs()+v] = _next_buf[o]->OccupancyFor(v);
     }
   }
   return result;
 }
 
-vector<int> IQRouter::FreeCredits() const
+template<int kInputs, int kOutputs, int kVCs>
+vector<int> IQRouterImpl<kInputs, kOutputs, kVCs>::FreeCredits() const
 {
-  vector<int> result(_outputs*_vcs);
-  for(int o = 0; o < _outputs; ++o) {
-    for(int v = 0; v < _vcs; ++v) {
-      result[o*_vcs+v] = _next_buf[o]->AvailableFor(v);
+  vector<int> result(_Outputs()*_VCs());
+  for(int o = 0; o < _Outputs(); ++o) {
+    for(int v = 0; v < _VCs(); ++v) {
+      result[o*_VCs()+v] = _next_buf[o]->AvailableFor(v);
     }
   }
   return result;
 }
 
-vector<int> IQRouter::MaxCredits() const
+template<int kInputs, int kOutputs, int kVCs>
+vector<int> IQRouterImpl<kInputs, kOutputs, kVCs>::MaxCredits() const
 {
-  vector<int> result(_outputs*_vcs);
-  for(int o = 0; o < _outputs; ++o) {
-    for(int v = 0; v < _vcs; ++v) {
-      result[o*_vcs+v] = _next_buf[o]->LimitFor(v);
+  vector<int> result(_Outputs()*_VCs());
+  for(int o = 0; o < _Outputs(); ++o) {
+    for(int v = 0; v < _VCs(); ++v) {
+      result[o*_VCs()+v] = _next_buf[o]->LimitFor(v);
     }
   }
   return result;
 }
 
-void IQRouter::_UpdateNOQ(int input, int vc, Flit const * f) {
+template<int kInputs, int kOutputs, int kVCs>
+void IQRouterImpl<kInputs, kOutputs, kVCs>::_UpdateNOQ(int input, int vc, Flit const * f) {
   assert(!_routing_delay);
   assert(f);
   assert(f->vc == vc);
   assert(f->head);
-  set<OutputSet::sSetElement> sl = f->la_route_set.GetSet();
+  OutputSet const & sl = f->la_route_set.GetSet();
   assert(sl.size() == 1);
   int out_port = sl.begin()->output_port;
   const FlitChannel * channel = _output_channels[out_port];
@@ -2361,20 +2488,19 @@ void IQRouter::_UpdateNOQ(int input, int vc, Flit const * f) {
     int in_channel = channel->GetSinkPort();
     OutputSet nos;
     _rf(router, f, in_channel, &nos, false);
-    sl = nos.GetSet();
-    assert(sl.size() == 1);
-    OutputSet::sSetElement const & se = *sl.begin();
+    assert(nos.size() == 1);
+    OutputSet::sSetElement const & se = *nos.begin();
     int next_output_port = se.output_port;
     assert(next_output_port >= 0);
     assert(_noq_next_output_port[input][vc] < 0);
     _noq_next_output_port[input][vc] = next_output_port;
     int next_vc_count = (se.vc_end - se.vc_start + 1) / router->NumOutputs();
     int next_vc_start = se.vc_start + next_output_port * next_vc_count;
-    assert(next_vc_start >= 0 && next_vc_start < _vcs);
+    assert(next_vc_start >= 0 && next_vc_start < _VCs());
     assert(_noq_next_vc_start[input][vc] < 0);
     _noq_next_vc_start[input][vc] = next_vc_start;
     int next_vc_end = se.vc_start + (next_output_port + 1) * next_vc_count - 1;
-    assert(next_vc_end >= 0 && next_vc_end < _vcs);
+    assert(next_vc_end >= 0 && next_vc_end < _VCs());
     assert(_noq_next_vc_end[input][vc] < 0);
     _noq_next_vc_end[input][vc] = next_vc_end;
     assert(next_vc_start <= next_vc_end);
@@ -2385,3 +2511,47 @@ void IQRouter::_UpdateNOQ(int input, int vc, Flit const * f) {
     }
   }
 }
+
+//------------------------------------------------------------------------------
+// router shapes
+//------------------------------------------------------------------------------
+
+/* the shapes of the example configs that are compiled with fixed counts
+ * when built with -DIQ_FIXED_SHAPES (make DEFINE=-DIQ_FIXED_SHAPES):
+ * PolarFly+ routers with polarflyport + hypercubeport + nic ports and 6 VCs
+ * (3D x F3, 2D x F5, 6D hypercube with 6 NICs and 6D x F7, one NIC
+ * otherwise) and the 32-port single-switch fat tree with one VC. Every
+ * shape adds a copy of the router to the binary and the example configs
+ * run no faster with them, so they are off by default. Any other shape,
+ * and every router of a default build, runs on the generic router.
+ */
+#ifdef IQ_FIXED_SHAPES
+template class IQRouterImpl<8, 8, 6>;
+template class IQRouterImpl<9, 9, 6>;
+template class IQRouterImpl<12, 12, 6>;
+template class IQRouterImpl<15, 15, 6>;
+template class IQRouterImpl<32, 32, 1>;
+#endif
+template class IQRouterImpl<0, 0, 0>;
+
+Router * IQRouter::New( Configuration const & config,
+			Module *parent, string const & name, int id,
+			int inputs, int outputs )
+{
+#ifdef IQ_FIXED_SHAPES
+  if(config.GetInt("iq_fixed_shape") > 0) {
+    int const vcs = config.GetInt("num_vcs");
+#define IQ_SHAPE(i, o, v)						\
+    if((inputs == i) && (outputs == o) && (vcs == v)) {			\
+      return new IQRouterImpl<i, o, v>(config, parent, name, id, inputs, outputs); \
+    }
+    IQ_SHAPE(8, 8, 6);
+    IQ_SHAPE(9, 9, 6);
+    IQ_SHAPE(12, 12, 6);
+    IQ_SHAPE(15, 15, 6);
+    IQ_SHAPE(32, 32, 1);
+#undef IQ_SHAPE
+  }
+#endif
+  return new IQRouterImpl<0, 0, 0>(config, parent, name, id, inputs, outputs);
+}
@@ -29,6 +29,8 @@
 #define _IQ_ROUTER_HPP_
 
 #include <string>
+#include <array>
+#include <cassert>
 #include <deque>
 #include <queue>
 #include <set>
@@ -36,6 +38,7 @@
 
 #include "router.hpp"
 #include "routefunc.hpp"
+#include "ringbuffer.hpp"
 
 using namespace std;
 
@@ -48,10 +51,61 @@ class Allocator;
 class SwitchMonitor;
 class BufferMonitor;
 
+// one entry per port: a std::array when the number of ports is fixed at
+// compile time, a vector sized by the router otherwise
+template<int N, class T> struct IQPorts {
+  typedef array<T, N> tArray;
+  static void Init( tArray & a, int n, T const & v ) { assert( n == N ); a.fill( v ); }
+};
+
+template<class T> struct IQPorts<0, T> {
+  typedef vector<T> tArray;
+  static void Init( tArray & a, int n, T const & v ) { a.assign( n, v ); }
+};
+
+// The input-queued router. IQRouterImpl is compiled for the router shapes
+// listed in IQRouter::New with the number of inputs, outputs and VCs fixed,
+// so that their loops and index computations use constants; a count of 0
+// is taken from the configuration at runtime.
 class IQRouter : public Router {
 
+protected:
+
+  // ----------------------------------------
+  //
+  //   Router Power Modellingyes
+  //
+  // ----------------------------------------
+
+  SwitchMonitor * _switchMonitor ;
+  BufferMonitor * _bufferMonitor ;
+
+  IQRouter( Configuration const & config,
+	    Module *parent, string const & name, int id,
+	    int inputs, int outputs )
+    : Router( config, parent, name, id, inputs, outputs ),
+      _switchMonitor( NULL ), _bufferMonitor( NULL ) { }
+
+public:
+
+  static Router * New( Configuration const & config,
+		       Module *parent, string const & name, int id,
+		       int inputs, int outputs );
+
+  SwitchMonitor const * const GetSwitchMonitor() const {return _switchMonitor;}
+  BufferMonitor const * const GetBufferMonitor() const {return _bufferMonitor;}
+
+};
+
+template<int kInputs, int kOutputs, int kVCs>
+class IQRouterImpl : public IQRouter {
+
   int _vcs;
 
+  inline int _Inputs( ) const { return kInputs ? kInputs : _inputs; }
+  inline int _Outputs( ) const { return kOutputs ? kOutputs : _outputs; }
+  inline int _VCs( ) const { return kVCs ? kVCs : _vcs; }
+
   bool _vc_busy_when_full;
   bool _vc_prioritize_empty;
   bool _vc_shuffle_requests;
@@ -67,21 +121,27 @@ class IQRouter : public Router {
   int _vc_alloc_delay;
   int _sw_alloc_delay;
   
-  map<int, Flit *> _in_queue_flits;
+  // flit received at each input in this cycle
+  typename IQPorts<kInputs, Flit *>::tArray _in_queue_flits;
+  int _in_queue_count;
 
-  deque<pair<int, pair<Credit *, int> > > _proc_credits;
+  // the pipeline stage queues are rings allocated for one entry per input
+  // VC when the router is built
+  RingBuffer<pair<int, pair<Credit *, int> > > _proc_credits;
 
-  deque<pair<int, pair<int, int> > > _route_vcs;
-  deque<pair<int, pair<pair<int, int>, int> > > _vc_alloc_vcs;  
-  deque<pair<int, pair<pair<int, int>, int> > > _sw_hold_vcs;
-  deque<pair<int, pair<pair<int, int>, int> > > _sw_alloc_vcs;
+  RingBuffer<pair<int, pair<int, int> > > _route_vcs;
+  RingBuffer<pair<int, pair<pair<int, int>, int> > > _vc_alloc_vcs;  
+  RingBuffer<pair<int, pair<pair<int, int>, int> > > _sw_hold_vcs;
+  RingBuffer<pair<int, pair<pair<int, int>, int> > > _sw_alloc_vcs;
 
-  deque<pair<int, pair<Flit *, pair<int, int> > > > _crossbar_flits;
+  RingBuffer<pair<int, pair<Flit *, pair<int, int> > > > _crossbar_flits;
 
-  map<int, Credit *> _out_queue_credits;
+  // credit to send back on each input in this cycle
+  typename IQPorts<kInputs, Credit *>::tArray _out_queue_credits;
+  int _out_queue_count;
 
-  vector<Buffer *> _buf;
-  vector<BufferState *> _next_buf;
+  typename IQPorts<kInputs, Buffer *>::tArray _buf;
+  typename IQPorts<kOutputs, BufferState *>::tArray _next_buf;
 
   Allocator *_vc_allocator;
   Allocator *_sw_allocator;
@@ -93,15 +153,19 @@ class IQRouter : public Router {
   tRoutingFunction   _rf;
 
   int _output_buffer_size;
-  vector<queue<Flit *> > _output_buffer;
+  typename IQPorts<kOutputs, queue<Flit *> >::tArray _output_buffer;
 
-  vector<queue<Credit *> > _credit_buffer;
+  typename IQPorts<kInputs, queue<Credit *> >::tArray _credit_buffer;
 
   bool _hold_switch_for_packet;
   vector<int> _switch_hold_in;
   vector<int> _switch_hold_out;
   vector<int> _switch_hold_vc;
 
+  // per expanded input, the first cycle after the flits of the last flit
+  // train sent from it
+  vector<int> _train_free_in;
+
   bool _noq;
   vector<vector<int> > _noq_next_output_port;
   vector<vector<int> > _noq_next_vc_start;
@@ -139,27 +203,20 @@ class IQRouter : public Router {
   
   void _UpdateNOQ(int input, int vc, Flit const * f);
 
-  // ----------------------------------------
-  //
-  //   Router Power Modellingyes
-  //
-  // ----------------------------------------
-
-  SwitchMonitor * _switchMonitor ;
-  BufferMonitor * _bufferMonitor ;
-  
 public:
 
-  IQRouter( Configuration const & config,
-	    Module *parent, string const & name, int id,
-	    int inputs, int outputs );
+  IQRouterImpl( Configuration const & config,
+		Module *parent, string const & name, int id,
+		int inputs, int outputs );
   
-  virtual ~IQRouter( );
+  virtual ~IQRouterImpl( );
   
   virtual void AddOutputChannel(FlitChannel * channel, CreditChannel * backchannel);
 
   virtual void ReadInputs( );
   virtual void WriteOutputs( );
+
+  virtual bool IsIdle( ) const;
   
   void Display( ostream & os = cout ) const;
 
@@ -175,9 +232,6 @@ public:
   virtual vector<int> FreeCredits() const;
   virtual vector<int> MaxCredits() const;
 
-  SwitchMonitor const * const GetSwitchMonitor() const {return _switchMonitor;}
-  BufferMonitor const * const GetBufferMonitor() const {return _bufferMonitor;}
-
 };
 
 #endif
@@ -42,6 +42,8 @@
 #include <iostream>
 #include <cassert>
 #include "router.hpp"
+#include "traffic.hpp"
+#include "event_trace.hpp"
 
 //////////////////Sub router types//////////////////////
 #include "iq_router.hpp"
@@ -55,6 +57,8 @@ int const Router::STALL_BUFFER_FULL = -4;
 int const Router::STALL_BUFFER_RESERVED = -5;
 int const Router::STALL_CROSSBAR_CONFLICT = -6;
 
+SteppedTrafficPattern const * Router::_schedule = NULL;
+
 Router::Router( const Configuration& config,
 		Module *parent, const string & name, int id,
 		int inputs, int outputs ) :
@@ -68,7 +72,11 @@ TimedModule( parent, name ), _id( id ), _inputs( inputs ), _outputs( outputs ),
   _output_speedup   = config.GetInt( "output_speedup" );
   _internal_speedup = config.GetFloat( "internal_speedup" );
   _classes          = config.GetInt( "classes" );
-
+  SetRandomStream( &_random );
+  // step counters are only kept while a collective gates the injection
+  if ( gCollective != COLLECTIVE_NONE ) {
+    _nic_steps.resize( max(config.GetInt( "nic" ), 1) );
+  }
 #ifdef TRACK_FLOWS
   _received_flits.resize(_classes, vector<int>(_inputs, 0));
   _stored_flits.resize(_classes);
@@ -92,6 +100,7 @@ void Router::AddInputChannel( FlitChannel *channel, CreditChannel *backchannel )
   _input_channels.push_back( channel );
   _input_credits.push_back( backchannel );
   channel->SetSink( this, _input_channels.size() - 1 ) ;
+  channel->SetReceiver( this );
 }
 
 void Router::AddOutputChannel( FlitChannel *channel, CreditChannel *backchannel )
@@ -100,6 +109,7 @@ void Router::AddOutputChannel( FlitChannel *channel, CreditChannel *backchannel
   _output_credits.push_back( backchannel );
   _channel_faults.push_back( false );
   channel->SetSource( this, _output_channels.size() - 1 ) ;
+  backchannel->SetReceiver( this );
 }
 
 void Router::Evaluate( )
@@ -111,6 +121,46 @@ void Router::Evaluate( )
   }
 }
 
+int Router::_StepThreshold( int nic, int step, int threshold, bool rx ) const
+{
+  assert( _schedule );
+  if ( step >= _schedule->Steps( ) ) {
+    return threshold;
+  }
+  int const node = _schedule->Node( _id, nic );
+  int const blocks = ( rx ?
+		       _schedule->RxBlocks( node, step ) :
+		       _schedule->TxBlocks( node, step ) );
+  return blocks * threshold;
+}
+
+void Router::_StepEvent( bool rx, int nic, int step ) const
+{
+  gEventTrace->Record( rx ? EventTrace::step_rx : EventTrace::step_tx,
+		       _id, nic, -1, -1, -1, step );
+}
+
+bool Router::step_skip( int threshold, int nic ) const
+{
+  assert( _schedule );
+  NicSteps & s = _Nic( nic );
+  int const step_tx = s.step_tx;
+  int const step_rx = s.step_rx;
+  int const steps = _schedule->Steps( );
+  while ( ( s.step_tx < steps ) && ( _TxThreshold( nic, s.step_tx, threshold ) == 0 ) ) {
+    s.step_tx++;
+    s.tx_counter = 0;
+    if ( gEventTrace ) _StepEvent( false, nic, s.step_tx );
+  }
+  while ( ( s.step_rx < steps ) &&
+	  ( _RxCounter( s, s.step_rx ) >= _RxThreshold( nic, s.step_rx, threshold ) ) ) {
+    _RxCounter( s, s.step_rx ) = 0;
+    s.step_rx++;
+    if ( gEventTrace ) _StepEvent( true, nic, s.step_rx );
+  }
+  return ( s.step_tx != step_tx ) || ( s.step_rx != step_rx );
+}
+
 void Router::OutChannelFault( int c, bool fault )
 {
   assert( ( c >= 0 ) && ( (size_t)c < _channel_faults.size( ) ) );
@@ -133,8 +183,7 @@ Router *Router::NewRouter( const Configuration& config,
   const string type = config.GetStr( "router" );
   Router *r = NULL;
   if ( type == "iq" ) {
-    r = new IQRouter( config, parent, name, id, inputs, outputs );
-    //cout << "New router id " << id << " name " << name << " parent " << parent->Name() << " input " << inputs << " output " << outputs << endl; 
+    r = IQRouter::New( config, parent, name, id, inputs, outputs );
   } else if ( type == "event" ) {
     r = new EventRouter( config, parent, name, id, inputs, outputs );
   } else if ( type == "chaos" ) {
@@ -27,19 +27,24 @@
 
 #ifndef _ROUTER_HPP_
 #define _ROUTER_HPP_
-
 #include <string>
 #include <vector>
 
+#include "globals.hpp"
 #include "timed_module.hpp"
 #include "flit.hpp"
 #include "credit.hpp"
 #include "flitchannel.hpp"
 #include "channel.hpp"
 #include "config_utils.hpp"
+#include "collective.hpp"
+#include "polarfly_tables.hpp"
+#include "random_utils.hpp"
 
 typedef Channel<Credit> CreditChannel;
 
+class SteppedTrafficPattern;
+
 class Router : public TimedModule {
 
 protected:
@@ -66,6 +71,63 @@ protected:
   int _crossbar_delay;
   int _credit_delay;
   
+  //mutable int _step_tx=0;
+  //mutable int _step_rx=0;
+  //mutable int _rx_counter[max_step]={0};
+  //mutable int _tx_counter=0;
+
+  // collective progress of one NIC. Received flits only have to be counted
+  // for steps that are not complete yet, so the counters form a ring over
+  // [step_rx, step_rx + rx_window.size()) that grows when a NIC receives
+  // further ahead.
+  struct NicSteps {
+    int step_tx;
+    int step_rx;
+    int tx_counter;
+    vector<int> rx_window;
+    NicSteps() : step_tx(0), step_rx(0), tx_counter(0), rx_window(16, 0) {}
+  };
+  // one entry per NIC, grown on demand when a NIC index beyond the
+  // configured count is used (switch mode counts per attached node)
+  mutable vector<NicSteps> _nic_steps;
+
+  NicSteps & _Nic( int nic ) const {
+    assert(nic >= 0);
+    if(nic >= (int)_nic_steps.size()) {
+      _nic_steps.resize(nic + 1);
+    }
+    return _nic_steps[nic];
+  }
+  int & _RxCounter( NicSteps & s, int step ) const {
+    int const size = s.rx_window.size();
+    if(step - s.step_rx >= size) {
+      int new_size = size;
+      while(step - s.step_rx >= new_size) {
+        new_size *= 2;
+      }
+      vector<int> window(new_size, 0);
+      for(int i = s.step_rx; i < s.step_rx + size; i++) {
+        window[i & (new_size - 1)] = s.rx_window[i & (size - 1)];
+      }
+      s.rx_window.swap(window);
+    }
+    return s.rx_window[step & (s.rx_window.size() - 1)];
+  }
+
+  // collective schedule whose steps carry different numbers of packets,
+  // NULL when every step carries the fixed threshold
+  static SteppedTrafficPattern const * _schedule;
+
+  int _StepThreshold( int nic, int step, int threshold, bool rx ) const;
+  inline int _TxThreshold( int nic, int step, int threshold ) const {
+    return _schedule ? _StepThreshold(nic, step, threshold, false) : threshold;
+  }
+  inline int _RxThreshold( int nic, int step, int threshold ) const {
+    return _schedule ? _StepThreshold(nic, step, threshold, true) : threshold;
+  }
+  // writes a step_tx or step_rx event of the event trace
+  void _StepEvent( bool rx, int nic, int step ) const;
+
   vector<FlitChannel *>   _input_channels;
   vector<CreditChannel *> _input_credits;
   vector<FlitChannel *>   _output_channels;
@@ -80,6 +142,9 @@ protected:
   vector<vector<int> > _active_packets;
 #endif
 
+  // drawn from by the routing function and the allocators with rng = stream
+  RandomStream _random;
+
 #ifdef TRACK_STALLS
   vector<int> _buffer_busy_stalls;
   vector<int> _buffer_conflict_stalls;
@@ -94,7 +159,7 @@ public:
   Router( const Configuration& config,
 	  Module *parent, const string & name, int id,
 	  int inputs, int outputs );
-
+  
   static Router *NewRouter( const Configuration& config,
 			    Module *parent, const string & name, int id,
 			    int inputs, int outputs );
@@ -120,6 +185,122 @@ public:
 
   inline int GetID( ) const { return _id;}
 
+  inline void SeedRandom( long seed, int index ) {
+    _random.Seed( seed, RandomStream::router, index );
+  }
+
+//----------------------collective pattern---------------------
+/*
+  int step_cal ( ) const {
+	  if(_step_rx > _step_tx){ return _step_tx;}
+	  else{ return _step_rx;}
+  }
+  bool step_chk(int threshold){
+     if(_tx_counter < threshold){
+       return true;
+     }
+     if(_step_rx >= _step_tx){
+        return true;
+     }
+
+     return false;
+  }
+  void rx_count ( int step, int threshold ) const {
+    _rx_counter[step]++;
+    while(_rx_counter[_step_rx] >= threshold){
+       _step_rx++;
+    }
+  }
+  void tx_count (int step , int threshold) const {
+    if(_step_tx == step) _tx_counter++;
+    if(_tx_counter == threshold){_step_tx++; _tx_counter=0;}
+  }
+  int Get_rx_step () const{ return _step_rx; }
+  int Get_tx_step () const{ return _step_tx; }
+  void step_reset () const{
+    _step_rx=0;
+    _step_tx=0;
+    for (int i = 0 ; i < max_step; i++){_rx_counter[i]=0;}
+    _tx_counter=0;
+  }
+  void step_txreset () const{
+    _step_tx=0;
+    _tx_counter=0;
+  }
+  void step_rxreset () const{
+    _step_rx=0;
+    for (int i = 0 ; i < max_step; i++){_rx_counter[i]=0;}
+  }
+  */
+  int step_cal (int nic) const {
+          NicSteps const & s = _Nic(nic);
+          if(s.step_rx > s.step_tx){ return s.step_tx;}
+          else{ return s.step_rx;}
+  }
+  bool step_chk(int threshold, int nic){
+     NicSteps const & s = _Nic(nic);
+     if(s.tx_counter < threshold){
+       return true;
+     }
+     if(s.step_rx >= s.step_tx){
+        return true;
+     }
+
+     return false;
+  }
+  void rx_count ( int step, int threshold, int nic ) const {
+    NicSteps & s = _Nic(nic);
+    // counts of completed steps are never read again
+    if(step >= s.step_rx) _RxCounter(s, step)++;
+    while(_RxCounter(s, s.step_rx) >= _RxThreshold(nic, s.step_rx, threshold)){
+       _RxCounter(s, s.step_rx) = 0;
+       s.step_rx++;
+       if(gEventTrace) _StepEvent(true, nic, s.step_rx);
+    }
+  }
+  void tx_count (int step , int threshold, int nic) const {
+    NicSteps & s = _Nic(nic);
+    if(s.step_tx == step) s.tx_counter++;
+    if(s.tx_counter >= _TxThreshold(nic, s.step_tx, threshold)){
+      s.step_tx++; s.tx_counter=0;
+      if(gEventTrace) _StepEvent(false, nic, s.step_tx);
+    }
+  }
+  // moves a NIC past the steps of the schedule in which it has nothing to
+  // send or to receive; returns true if either step counter advanced
+  bool step_skip ( int threshold, int nic ) const;
+  int Get_rx_step (int nic) const{ return _Nic(nic).step_rx; }
+  int Get_tx_step (int nic) const{ return _Nic(nic).step_tx; }
+  void step_reset (int nic) const{
+    step_txreset(nic);
+    step_rxreset(nic);
+  }
+  void step_txreset (int nic) const{
+    NicSteps & s = _Nic(nic);
+    s.step_tx=0;
+    s.tx_counter=0;
+  }
+  void step_rxreset (int nic) const{
+    NicSteps & s = _Nic(nic);
+    s.step_rx=0;
+    s.rx_window.assign(s.rx_window.size(), 0);
+  }
+  int Get_min_step ( ) const {
+     int minstep=max_step;
+     for (int i = 0; i < (int)_nic_steps.size(); i++){
+        if((this->step_cal(i) < minstep) && (this->step_cal(i) > 0)){
+	  minstep = this->step_cal(i);
+	}
+     }
+     return minstep;
+  }
+  static void SetCollectiveSchedule( SteppedTrafficPattern const * schedule ) {
+    _schedule = schedule;
+  }
+  static SteppedTrafficPattern const * GetCollectiveSchedule( ) {
+    return _schedule;
+  }
+  //--------------------------------------------------------------
 
   virtual int GetUsedCredit(int o) const = 0;
   virtual int GetBufferOccupancy(int i) const = 0;
@@ -0,0 +1,286 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*sweep.cpp
+ *
+ *The routing tables, the PolarFly tables and the route and fault tables are
+ *process-wide, so the points are not run on threads of one process. Each
+ *point forks from the process that built the network, which shares those
+ *tables and starts from an untouched network, so a point gives the same
+ *result as a run of its own.
+ *
+ */
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include "booksim.hpp"
+#include "sweep.hpp"
+#include "collective.hpp"
+#include "network.hpp"
+#include "trafficmanager.hpp"
+
+extern TrafficManager * trafficManager;
+
+struct SweepPoint {
+  int packet_size;
+  double injection_rate;
+  string seed;
+};
+
+bool SweepRequested( Configuration const & config )
+{
+  return ( !config.GetStr( "sweep_injection_rate" ).empty( ) ||
+	   !config.GetStr( "sweep_packet_size" ).empty( ) ||
+	   !config.GetStr( "sweep_seed" ).empty( ) );
+}
+
+// every combination of the listed values, the seeds varying fastest; a
+// list that is not given holds the value of the config
+static vector<SweepPoint> _SweepPoints( Configuration const & config )
+{
+  vector<int> sizes = config.GetIntArray( "sweep_packet_size" );
+  bool const sweep_sizes = !sizes.empty( );
+  if ( !sweep_sizes ) {
+    sizes.push_back( config.GetInt( "packet_size" ) );
+  }
+  vector<double> rates = config.GetFloatArray( "sweep_injection_rate" );
+  bool const sweep_rates = !rates.empty( );
+  if ( !sweep_rates ) {
+    rates.push_back( config.GetFloat( "injection_rate" ) );
+  }
+  vector<string> seeds = config.GetStrArray( "sweep_seed" );
+  if ( seeds.empty( ) ) {
+    string const seed = config.GetStr( "seed" );
+    if ( seed.empty( ) ) {
+      ostringstream os;
+      os << config.GetInt( "seed" );
+      seeds.push_back( os.str( ) );
+    } else {
+      seeds.push_back( seed );
+    }
+  }
+
+  vector<SweepPoint> points;
+  for ( size_t s = 0; s < sizes.size( ); ++s ) {
+    if ( sizes[s] < 1 ) {
+      cout << "Error: sweep_packet_size must list sizes of at least one flit." << endl;
+      exit(-1);
+    }
+    for ( size_t r = 0; r < rates.size( ); ++r ) {
+      for ( size_t d = 0; d < seeds.size( ); ++d ) {
+	SweepPoint p;
+	p.packet_size = sizes[s];
+	p.injection_rate = rates[r];
+	// a collective injects one packet per cycle and NIC
+	if ( sweep_sizes && !sweep_rates && ( gCollective != COLLECTIVE_NONE ) ) {
+	  p.injection_rate = 1.0 / (double)sizes[s];
+	}
+	p.seed = seeds[d];
+	points.push_back( p );
+      }
+    }
+  }
+  return points;
+}
+
+static string _PointFields( int index, SweepPoint const & p )
+{
+  ostringstream os;
+  os << index << ',' << p.packet_size << ',' << p.injection_rate << ',' << p.seed;
+  return os.str( );
+}
+
+// runs in the child process and never returns
+static void _RunPoint( BookSimConfig const & config, vector<Network *> const & net,
+		       int index, SweepPoint const & p, int fd )
+{
+  BookSimConfig point_config = config;
+  point_config.Assign( "packet_size", string( "" ) );
+  point_config.Assign( "packet_size", p.packet_size );
+  point_config.Assign( "injection_rate", string( "" ) );
+  point_config.Assign( "injection_rate", p.injection_rate );
+  if ( p.seed == "time" ) {
+    point_config.Assign( "seed", p.seed );
+  } else {
+    point_config.Assign( "seed", string( "" ) );
+    point_config.Assign( "seed", atoi( p.seed.c_str( ) ) );
+  }
+
+  string log = "/dev/null";
+  if ( config.GetInt( "sweep_log" ) ) {
+    ostringstream name;
+    name << config.GetStr( "sweep_out" ) << '.' << index << ".log";
+    log = name.str( );
+  }
+  if ( !freopen( log.c_str( ), "w", stdout ) ) {
+    _exit( 2 );
+  }
+
+  trafficManager = TrafficManager::New( point_config, net );
+  bool const result = trafficManager->Run( );
+
+  ostringstream stats;
+  trafficManager->DisplayOverallStatsCSV( stats );
+  string csv = stats.str( );
+  csv = csv.substr( 0, csv.find( '\n' ) );
+  size_t const skip = csv.find( ',' );
+  csv = ( skip == string::npos ) ? "" : csv.substr( skip + 1 );
+
+  ostringstream row;
+  row << _PointFields( index, p ) << ',' << ( result ? "ok" : "unstable" )
+      << ',' << trafficManager->getTime( ) << ',' << csv << endl;
+  string const line = row.str( );
+  cout.flush( );
+  size_t done = 0;
+  while ( done < line.size( ) ) {
+    ssize_t const n = write( fd, line.data( ) + done, line.size( ) - done );
+    if ( n <= 0 ) {
+      _exit( 2 );
+    }
+    done += n;
+  }
+  close( fd );
+  _exit( 0 );
+}
+
+bool Sweep( BookSimConfig const & config )
+{
+  if ( config.GetStr( "event_trace_out" ) != "" ) {
+    cout << "Error: event_trace_out cannot be used with a sweep." << endl;
+    exit(-1);
+  }
+  int const jobs = config.GetInt( "sweep_jobs" );
+  if ( jobs < 1 ) {
+    cout << "Error: sweep_jobs must be at least 1." << endl;
+    exit(-1);
+  }
+  vector<SweepPoint> const points = _SweepPoints( config );
+
+  vector<Network *> net( config.GetInt( "subnets" ) );
+  for ( size_t i = 0; i < net.size( ); ++i ) {
+    ostringstream name;
+    name << "network_" << i;
+    net[i] = Network::New( config, name.str( ) );
+  }
+
+  string const out_file = config.GetStr( "sweep_out" );
+  ofstream out( out_file.c_str( ) );
+  if ( !out ) {
+    cout << "Error: unable to open sweep output file " << out_file << endl;
+    exit(-1);
+  }
+  out << "point,packet_size,injection_rate,seed,status,cycles,"
+      << "traffic,use_read_write,load,"
+      << "min_plat,avg_plat,max_plat,min_nlat,avg_nlat,max_nlat,"
+      << "min_flat,avg_flat,max_flat,min_frag,avg_frag,max_frag,"
+      << "min_sent_packets,avg_sent_packets,max_sent_packets,"
+      << "min_accepted_packets,avg_accepted_packets,max_accepted_packets,"
+      << "min_sent,avg_sent,max_sent,min_accepted,avg_accepted,max_accepted,"
+      << "sent_packet_size,accepted_packet_size,hops" << endl;
+
+  cout << "sweep: " << points.size( ) << " points, " << jobs << " at a time" << endl;
+
+  // rows are written in the order of the points as they complete
+  vector<string> rows( points.size( ) );
+  vector<bool> complete( points.size( ), false );
+  size_t written = 0;
+  map<pid_t, pair<int, int> > running; // child -> point, read end of its pipe
+  size_t next = 0;
+  bool all_ok = true;
+  while ( ( next < points.size( ) ) || !running.empty( ) ) {
+    while ( ( next < points.size( ) ) && ( (int)running.size( ) < jobs ) ) {
+      int fds[2];
+      if ( pipe( fds ) != 0 ) {
+	cout << "Error: unable to create a pipe for sweep point " << next << endl;
+	exit(-1);
+      }
+      cout.flush( );
+      pid_t const pid = fork( );
+      if ( pid < 0 ) {
+	cout << "Error: unable to start sweep point " << next << endl;
+	exit(-1);
+      }
+      if ( pid == 0 ) {
+	close( fds[0] );
+	_RunPoint( config, net, next, points[next], fds[1] );
+      }
+      close( fds[1] );
+      running[pid] = make_pair( (int)next, fds[0] );
+      ++next;
+    }
+
+    int status;
+    pid_t const pid = wait( &status );
+    if ( pid < 0 ) {
+      break;
+    }
+    map<pid_t, pair<int, int> >::iterator const child = running.find( pid );
+    if ( child == running.end( ) ) {
+      continue;
+    }
+    int const index = child->second.first;
+    int const fd = child->second.second;
+    running.erase( child );
+
+    string row;
+    char buf[4096];
+    ssize_t n;
+    while ( ( n = read( fd, buf, sizeof( buf ) ) ) > 0 ) {
+      row.append( buf, n );
+    }
+    close( fd );
+    if ( row.empty( ) || !WIFEXITED( status ) || ( WEXITSTATUS( status ) != 0 ) ) {
+      row = _PointFields( index, points[index] ) + ",failed\n";
+    }
+    if ( row.find( ",ok," ) == string::npos ) {
+      all_ok = false;
+    }
+    rows[index] = row;
+    complete[index] = true;
+    cout << "sweep: point " << index << " done" << endl;
+
+    while ( ( written < rows.size( ) ) && complete[written] ) {
+      out << rows[written];
+      rows[written].clear( );
+      ++written;
+    }
+    out.flush( );
+  }
+
+  for ( size_t i = 0; i < net.size( ); ++i ) {
+    delete net[i];
+  }
+  return all_ok;
+}
@@ -25,36 +25,22 @@
  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-#ifndef _CREDIT_HPP_
-#define _CREDIT_HPP_
+/*sweep.hpp
+ *
+ *Runs the points of a parameter sweep on one network. The network and the
+ *routing tables are built once, and every point is simulated in a child
+ *process that starts from a copy-on-write image of them.
+ *
+ */
 
-#include <set>
-#include <stack>
+#ifndef _SWEEP_HPP_
+#define _SWEEP_HPP_
 
-class Credit {
+#include "booksim_config.hpp"
 
-public:
+// true if the config lists injection rates, packet sizes or seeds to sweep
+bool SweepRequested( Configuration const & config );
 
-  set<int> vc;
-
-  // these are only used by the event router
-  bool head, tail;
-  int  id;
-
-  void Reset();
-  
-  static Credit * New();
-  void Free();
-  static void FreeAll();
-  static int OutStanding();
-private:
-
-  static stack<Credit *> _all;
-  static stack<Credit *> _free;
-
-  Credit();
-  ~Credit() {}
-
-};
+bool Sweep( BookSimConfig const & config );
 
 #endif
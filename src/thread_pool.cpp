@@ -0,0 +1,121 @@
+// $Id$
+
+/*
+ Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this 
+ list of conditions and the following disclaimer.
+ Redistributions in binary form must reproduce the above copyright notice, this
+ list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*thread_pool.cpp
+ *
+ *Workers spin for a short while after each range before they block, since
+ *the next phase of the cycle usually follows right away.
+ *
+ */
+
+#include <cassert>
+
+#include "thread_pool.hpp"
+#include "random_utils.hpp"
+
+static int const kSpinCount = 4096;
+
+ThreadPool::ThreadPool( int threads )
+  : _threads(threads), _generation(0), _pending(0), _stop(false),
+    _task(NULL), _count(0)
+{
+  assert(_threads >= 1);
+  for ( int t = 1; t < _threads; ++t ) {
+    _workers.push_back(thread(&ThreadPool::_Worker, this, t));
+  }
+}
+
+ThreadPool::~ThreadPool( )
+{
+  {
+    lock_guard<mutex> lock(_mutex);
+    _stop = true;
+    ++_generation;
+  }
+  _start.notify_all( );
+  for ( size_t t = 0; t < _workers.size(); ++t ) {
+    _workers[t].join( );
+  }
+}
+
+void ThreadPool::_RunRange( int id )
+{
+  int const begin = (int)(((long long)_count * id) / _threads);
+  int const end = (int)(((long long)_count * (id + 1)) / _threads);
+  if ( begin < end ) {
+    gParallelPhase = true;
+    (*_task)(begin, end);
+    gParallelPhase = false;
+  }
+}
+
+void ThreadPool::_Worker( int id )
+{
+  unsigned long seen = 0;
+  while ( true ) {
+    int spins = 0;
+    while ( _generation.load(memory_order_acquire) == seen ) {
+      if ( ++spins < kSpinCount ) {
+	this_thread::yield( );
+      } else {
+	unique_lock<mutex> lock(_mutex);
+	while ( _generation.load(memory_order_acquire) == seen ) {
+	  _start.wait(lock);
+	}
+      }
+    }
+    seen = _generation.load(memory_order_acquire);
+    if ( _stop ) {
+      return;
+    }
+    _RunRange(id);
+    _pending.fetch_sub(1, memory_order_acq_rel);
+  }
+}
+
+void ThreadPool::Run( int count, tRangeTask const & task )
+{
+  if ( _threads == 1 ) {
+    if ( count > 0 ) {
+      task(0, count);
+    }
+    return;
+  }
+  _task = &task;
+  _count = count;
+  _pending.store(_threads - 1, memory_order_relaxed);
+  {
+    lock_guard<mutex> lock(_mutex);
+    _generation.fetch_add(1, memory_order_release);
+  }
+  _start.notify_all( );
+  _RunRange(0);
+  while ( _pending.load(memory_order_acquire) != 0 ) {
+    this_thread::yield( );
+  }
+  _task = NULL;
+}
@@ -25,47 +25,55 @@
  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-// ----------------------------------------------------------------------
-//
-//  Matrix: Matrix Arbiter
-//
-// ----------------------------------------------------------------------
-
-#ifndef _MATRIX_ARB_HPP_
-#define _MATRIX_ARB_HPP_
+/*thread_pool.hpp
+ *
+ *A fixed set of worker threads used to run the phases of a simulation cycle
+ *in parallel. Run() splits [0,count) into one contiguous range per thread,
+ *the calling thread works on the first range and Run() returns once every
+ *range is done, which makes each call a barrier.
+ *
+ */
+
+#ifndef _THREAD_POOL_HPP_
+#define _THREAD_POOL_HPP_
 
 #include <vector>
-
-#include "arbiter.hpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
 
 using namespace std;
 
-class MatrixArbiter : public Arbiter {
-
-  // Priority matrix
-  vector<vector<int> > _matrix ;
-
-  int  _last_req ;
+class ThreadPool {
 
 public:
+  typedef function<void( int begin, int end )> tRangeTask;
+
+private:
+  int _threads;
+  vector<thread> _workers;
 
-  // Constructors
-  MatrixArbiter( Module *parent, const string &name, int size ) ;
+  mutex _mutex;
+  condition_variable _start;
+  atomic<unsigned long> _generation;
+  atomic<int> _pending;
+  bool _stop;
 
-  // Print priority matrix to standard output
-  virtual void PrintState() const ;
-  
-  // Update priority matrix based on last aribtration result
-  virtual void UpdateState() ; 
+  tRangeTask const * _task;
+  int _count;
 
-  // Arbitrate amongst requests. Returns winning input and 
-  // updates pointers to metadata when valid pointers are passed
-  virtual int Arbitrate( int* id = 0, int* pri = 0) ;
+  void _Worker( int id );
+  void _RunRange( int id );
 
-  virtual void AddRequest( int input, int id, int pri ) ;
+public:
+  ThreadPool( int threads );
+  ~ThreadPool( );
 
-  virtual void Clear();
+  int NumThreads( ) const { return _threads; }
 
-} ;
+  void Run( int count, tRangeTask const & task );
+};
 
 #endif
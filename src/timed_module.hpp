@@ -28,17 +28,37 @@
 #ifndef _TIMED_MODULE_HPP_
 #define _TIMED_MODULE_HPP_
 
+#include <atomic>
+
 #include "module.hpp"
 
+class RandomStream;
+
 class TimedModule : public Module {
 
+  // set while the network has to evaluate this module
+  std::atomic<unsigned char> * _awake;
+
+  // stream the module draws from with rng = stream, NULL if it draws none
+  RandomStream * _random;
+
 public:
-  TimedModule(Module * parent, string const & name) : Module(parent, name) {}
+  TimedModule(Module * parent, string const & name) : Module(parent, name), _awake(0), _random(0) {}
   virtual ~TimedModule() {}
   
   virtual void ReadInputs() = 0;
   virtual void Evaluate() = 0;
   virtual void WriteOutputs() = 0;
+
+  // true if the module will not change until something is sent to it
+  virtual bool IsIdle() const { return false; }
+
+  inline void SetActivityFlag(std::atomic<unsigned char> * awake) { _awake = awake; }
+  inline RandomStream * GetRandomStream() const { return _random; }
+  inline void SetRandomStream(RandomStream * random) { _random = random; }
+  inline void Wake() const {
+    if(_awake) _awake->store(1, std::memory_order_relaxed);
+  }
 };
 
 #endif
@@ -28,8 +28,13 @@
 #include <iostream>
 #include <sstream>
 #include <ctime>
+#include <algorithm>
 #include "random_utils.hpp"
 #include "traffic.hpp"
+#include "collective.hpp"
+#include "polarfly_tables.hpp"
+
+int NIC;
 
 TrafficPattern::TrafficPattern(int nodes)
 : _nodes(nodes)
@@ -45,9 +50,70 @@ void TrafficPattern::reset()
 
 }
 
+// Traffic patterns that run as a collective: the algorithm that steps the
+// NICs through them and how the pattern is built. New schedules are added
+// here only, so that a schedule cannot run as random traffic by mistake.
+struct CollectivePattern {
+  char const * name;
+  char const * collective;
+  TrafficPattern * (*create)(int nodes, Configuration const * config);
+};
+
+static CollectivePattern const gCollectivePatterns[] = {
+  { "pairwise", "pairwise",
+    [](int nodes, Configuration const *) -> TrafficPattern *
+    { return new PairwiseTrafficPattern(nodes); } },
+  { "ring", "ring",
+    [](int nodes, Configuration const *) -> TrafficPattern *
+    { return new RingTrafficPattern(nodes); } },
+  { "recursive_doubling", "pairwise",
+    [](int nodes, Configuration const *) -> TrafficPattern *
+    { return new RecursiveDoublingTrafficPattern(nodes); } },
+  { "halving_doubling", "pairwise",
+    [](int nodes, Configuration const *) -> TrafficPattern *
+    { return new HalvingDoublingTrafficPattern(nodes); } },
+  { "bruck", "pairwise",
+    [](int nodes, Configuration const *) -> TrafficPattern *
+    { return new BruckTrafficPattern(nodes); } },
+  { "binomial_broadcast", "pairwise",
+    [](int nodes, Configuration const *) -> TrafficPattern *
+    { return new BinomialTreeTrafficPattern(nodes, false); } },
+  { "binomial_reduce", "pairwise",
+    [](int nodes, Configuration const *) -> TrafficPattern *
+    { return new BinomialTreeTrafficPattern(nodes, true); } },
+  { "binary_broadcast", "pairwise",
+    [](int nodes, Configuration const *) -> TrafficPattern *
+    { return new BinaryTreeTrafficPattern(nodes, false); } },
+  { "binary_reduce", "pairwise",
+    [](int nodes, Configuration const *) -> TrafficPattern *
+    { return new BinaryTreeTrafficPattern(nodes, true); } },
+  { "hierarchical", "pairwise",
+    [](int nodes, Configuration const * config) -> TrafficPattern *
+    { return new HierarchicalTrafficPattern(nodes, PolarFlyPlusHypercubePorts(*config)); } },
+};
+
+static CollectivePattern const * FindCollectivePattern(string const & pattern_name)
+{
+  for(size_t i = 0; i < sizeof(gCollectivePatterns) / sizeof(gCollectivePatterns[0]); ++i) {
+    if(pattern_name == gCollectivePatterns[i].name) {
+      return &gCollectivePatterns[i];
+    }
+  }
+  return NULL;
+}
+
+string TrafficPattern::Collective(string const & pattern)
+{
+  CollectivePattern const * const collective =
+    FindCollectivePattern(pattern.substr(0, pattern.find('(')));
+  return collective ? collective->collective : "none";
+}
+
 TrafficPattern * TrafficPattern::New(string const & pattern, int nodes, 
 				     Configuration const * const config)
 {
+  NIC = config->GetInt("nic");
+
   string pattern_name;
   string param_str;
   size_t left = pattern.find_first_of('(');
@@ -65,7 +131,10 @@ TrafficPattern * TrafficPattern::New(string const & pattern, int nodes,
   vector<string> params = tokenize_str(param_str);
   
   TrafficPattern * result = NULL;
-  if(pattern_name == "bitcomp") {
+  CollectivePattern const * const collective = FindCollectivePattern(pattern_name);
+  if(collective) {
+    result = collective->create(nodes, config);
+  } else if(pattern_name == "bitcomp") {
     result = new BitCompTrafficPattern(nodes);
   } else if(pattern_name == "transpose") {
     result = new TransposeTrafficPattern(nodes);
@@ -249,6 +318,421 @@ int TransposeTrafficPattern::dest(int source)
   return (((source >> _shift) & mask_lo) | ((source << _shift) & mask_hi));
 }
 
+PairwiseTrafficPattern::PairwiseTrafficPattern(int nodes)
+: TrafficPattern(nodes)
+{
+}
+
+//int PairwiseTrafficPattern::dest(int source)
+//{
+//  assert((source >= 0) && (source < _nodes));
+//#ifdef PFP_TRAFFIC_DEBUG
+//  cout << "PairwiseTrafficPattern source:" << source << " step:" << step_table[source] << " dest:" << (source ^ (1 << step_table[source])) << endl; 
+//#endif
+//  return (source ^ (1 << step_table[source]));
+//}
+int PairwiseTrafficPattern::dest(int source)
+{
+  assert((source >= 0) && (source < _nodes));
+  int destnic = (source % NIC);
+  int max_step_threshold = 0; 
+  for (int i = 0; i < max_step; i++){
+    if( ( 1 << i ) >= _nodes/NIC ) {
+       max_step_threshold = i;
+       break;
+    }
+  }
+  int step = step_table[source/NIC][destnic];  
+  int destrouter = (source/NIC) ^ (1 << ((step+destnic) % max_step_threshold));
+  int destnode = (destrouter*NIC)+destnic;
+  
+  if(gSingleSwitch) {
+    destnic = source;
+    step = step_table[0][source];
+    destnode = source ^ (1 << ((step_table[0][source]) % max_step_threshold));
+    destrouter = 0;
+  }
+
+#ifdef PAIRWISE_TRAFFIC_DEBUG
+  cout << "PairwiseTrafficPattern source:" << source << " step:" << step << " destrouter:" << destrouter << " nic:" << destnic << " destnode:" << destnode << endl;
+#endif
+  return destnode;
+}
+
+RingTrafficPattern::RingTrafficPattern(int nodes)
+: TrafficPattern(nodes)
+{
+}
+
+//int RingTrafficPattern::dest(int source)
+//{
+//  assert((source >= 0) && (source < _nodes));
+//#ifdef PFP_TRAFFIC_DEBUG
+//  cout << "RingTrafficPattern source:" << source << " step:" << step_table[source] << " dest:" << ( (source + 1) % _nodes ) << endl;
+//#endif
+//  return ((source + 1) % _nodes) ;
+//}
+
+int RingTrafficPattern::dest(int source)
+{
+  assert((source >= 0) && (source < _nodes));
+
+  int destnic = source % NIC;
+  int destrouter = ( (source/NIC) + 1 ) % (_nodes/NIC);
+  if( destnic == 1 ) destrouter = ( (source/NIC) - 1 + _nodes) % (_nodes/NIC);
+  int destnode = (destrouter * NIC) + destnic;
+
+  if(gSingleSwitch) {
+    destnic = source;
+    destnode = (source+1) % _nodes;
+    //if( destnic == 1 ) destnode = (source-1+_nodes) % _nodes;
+    destrouter = 0;
+  }
+
+#ifdef RING_TRAFFIC_DEBUG
+  cout << "RingTrafficPattern source:" << source << " step:" << step_table[source/NIC][destnic] << " destrouter:" << destrouter << " nic:" << destnic << " destnode:" << destnode << endl;
+#endif
+  return destnode ;
+}
+
+// smallest l with (1 << l) >= n
+static int log2_ceil(int n)
+{
+  int l = 0;
+  while((1 << l) < n) {
+    ++l;
+  }
+  return l;
+}
+
+// largest l with (1 << l) <= n
+static int log2_floor(int n)
+{
+  int l = 0;
+  while((2 << l) <= n) {
+    ++l;
+  }
+  return l;
+}
+
+static int ceil_div(int a, int b)
+{
+  return (a + b - 1) / b;
+}
+
+// Schedules built from pairwise exchanges only pair up the largest power of
+// two p of ranks. If n != p, the ranks from p up first fold their data into
+// rank - p and are sent the result in a final step.
+static int fold_steps(int n, int exchanges)
+{
+  return exchanges + ((n != (1 << log2_floor(n))) ? 2 : 0);
+}
+
+// Returns the peer of rank i in a fold step (-1 if idle) and sets exchange
+// to the exchange step index, or to -1 for fold steps.
+static int fold_peer(int i, int n, int step, int exchanges, bool send,
+		     int & exchange)
+{
+  int const p = 1 << log2_floor(n);
+  exchange = -1;
+  if(p != n) {
+    if(step == 0) {
+      return send ? ((i >= p) ? (i - p) : -1) : ((i + p < n) ? (i + p) : -1);
+    }
+    if(step == exchanges + 1) {
+      return send ? ((i + p < n) ? (i + p) : -1) : ((i >= p) ? (i - p) : -1);
+    }
+    --step;
+  }
+  if(i < p) {
+    exchange = step;
+  }
+  return -1;
+}
+
+static int fold_exchange(int n, int step, int exchanges)
+{
+  int exchange;
+  fold_peer(0, n, step, exchanges, true, exchange);
+  return exchange;
+}
+
+SteppedTrafficPattern::SteppedTrafficPattern(int nodes)
+  : TrafficPattern(nodes), _steps(0)
+{
+  if(gSingleSwitch) {
+    _ranks = nodes;
+  } else {
+    if((NIC <= 0) || (nodes % NIC)) {
+      cout << "Error: Collective schedules require the nodes to be split evenly over " << NIC << " NICs." << endl;
+      exit(-1);
+    }
+    _ranks = nodes / NIC;
+  }
+}
+
+int SteppedTrafficPattern::_Rank(int node) const
+{
+  return gSingleSwitch ? node : (node / NIC);
+}
+
+int SteppedTrafficPattern::_Node(int rank, int node) const
+{
+  return gSingleSwitch ? rank : ((rank * NIC) + (node % NIC));
+}
+
+int SteppedTrafficPattern::Node(int router, int nic) const
+{
+  return gSingleSwitch ? nic : ((router * NIC) + nic);
+}
+
+int SteppedTrafficPattern::dest(int source)
+{
+  assert((source >= 0) && (source < _nodes));
+  int const step = gSingleSwitch ? step_table[0][source] : step_table[source/NIC][source%NIC];
+  return dest(source, step);
+}
+
+int SteppedTrafficPattern::dest(int source, int step)
+{
+  if((step < 0) || (step >= _steps)) {
+    return -1;
+  }
+  int const peer = _SendTo(_Rank(source), step);
+  return (peer < 0) ? -1 : _Node(peer, source);
+}
+
+int SteppedTrafficPattern::TxBlocks(int node, int step) const
+{
+  return (_SendTo(_Rank(node), step) < 0) ? 0 : _Blocks(step);
+}
+
+int SteppedTrafficPattern::RxBlocks(int node, int step) const
+{
+  return (_RecvFrom(_Rank(node), step) < 0) ? 0 : _Blocks(step);
+}
+
+RecursiveDoublingTrafficPattern::RecursiveDoublingTrafficPattern(int nodes)
+  : SteppedTrafficPattern(nodes)
+{
+  _steps = fold_steps(_ranks, log2_floor(_ranks));
+}
+
+int RecursiveDoublingTrafficPattern::_SendTo(int rank, int step) const
+{
+  int exchange;
+  int const peer = fold_peer(rank, _ranks, step, log2_floor(_ranks), true, exchange);
+  return (exchange < 0) ? peer : (rank ^ (1 << exchange));
+}
+
+int RecursiveDoublingTrafficPattern::_RecvFrom(int rank, int step) const
+{
+  int exchange;
+  int const peer = fold_peer(rank, _ranks, step, log2_floor(_ranks), false, exchange);
+  return (exchange < 0) ? peer : (rank ^ (1 << exchange));
+}
+
+int RecursiveDoublingTrafficPattern::_Blocks(int step) const
+{
+  return _ranks;
+}
+
+HalvingDoublingTrafficPattern::HalvingDoublingTrafficPattern(int nodes)
+  : SteppedTrafficPattern(nodes)
+{
+  _exchanges = 2 * log2_floor(_ranks);
+  _steps = fold_steps(_ranks, _exchanges);
+}
+
+// the reduce-scatter halves the distance from p/2 down to 1, the all-gather
+// doubles it back
+int HalvingDoublingTrafficPattern::_SendTo(int rank, int step) const
+{
+  int exchange;
+  int const peer = fold_peer(rank, _ranks, step, _exchanges, true, exchange);
+  if(exchange < 0) {
+    return peer;
+  }
+  int const half = _exchanges / 2;
+  return rank ^ ((exchange < half) ?
+		 (1 << (half - 1 - exchange)) :
+		 (1 << (exchange - half)));
+}
+
+int HalvingDoublingTrafficPattern::_RecvFrom(int rank, int step) const
+{
+  int exchange;
+  int const peer = fold_peer(rank, _ranks, step, _exchanges, false, exchange);
+  if(exchange < 0) {
+    return peer;
+  }
+  return _SendTo(rank, step);
+}
+
+int HalvingDoublingTrafficPattern::_Blocks(int step) const
+{
+  int const exchange = fold_exchange(_ranks, step, _exchanges);
+  if(exchange < 0) {
+    return _ranks;
+  }
+  int const half = _exchanges / 2;
+  return (exchange < half) ?
+    ceil_div(_ranks, 1 << (exchange + 1)) :
+    ceil_div(_ranks, 1 << (_exchanges - exchange));
+}
+
+BruckTrafficPattern::BruckTrafficPattern(int nodes)
+  : SteppedTrafficPattern(nodes)
+{
+  _steps = log2_ceil(_ranks);
+}
+
+int BruckTrafficPattern::_SendTo(int rank, int step) const
+{
+  return (rank + (1 << step)) % _ranks;
+}
+
+int BruckTrafficPattern::_RecvFrom(int rank, int step) const
+{
+  return (rank - (1 << step) % _ranks + _ranks) % _ranks;
+}
+
+// blocks j in [0, ranks) with bit step set
+int BruckTrafficPattern::_Blocks(int step) const
+{
+  int const bit = 1 << step;
+  int const rest = _ranks % (2 * bit);
+  return (_ranks / (2 * bit)) * bit + ((rest > bit) ? (rest - bit) : 0);
+}
+
+TreeTrafficPattern::TreeTrafficPattern(int nodes, bool reduce)
+  : SteppedTrafficPattern(nodes), _reduce(reduce)
+{
+}
+
+int TreeTrafficPattern::_SendTo(int rank, int step) const
+{
+  return _reduce ? _Parent(rank, _steps - 1 - step) : _Child(rank, step);
+}
+
+int TreeTrafficPattern::_RecvFrom(int rank, int step) const
+{
+  return _reduce ? _Child(rank, _steps - 1 - step) : _Parent(rank, step);
+}
+
+int TreeTrafficPattern::_Blocks(int step) const
+{
+  return _ranks;
+}
+
+BinomialTreeTrafficPattern::BinomialTreeTrafficPattern(int nodes, bool reduce)
+  : TreeTrafficPattern(nodes, reduce)
+{
+  _steps = log2_ceil(_ranks);
+}
+
+int BinomialTreeTrafficPattern::_Child(int rank, int step) const
+{
+  int const child = rank + (1 << step);
+  return ((rank < (1 << step)) && (child < _ranks)) ? child : -1;
+}
+
+int BinomialTreeTrafficPattern::_Parent(int rank, int step) const
+{
+  return ((rank >= (1 << step)) && (rank < (2 << step))) ? (rank - (1 << step)) : -1;
+}
+
+BinaryTreeTrafficPattern::BinaryTreeTrafficPattern(int nodes, bool reduce)
+  : TreeTrafficPattern(nodes, reduce)
+{
+  for(int rank = 1; rank < _ranks; ++rank) {
+    _steps = max(_steps, _Round(rank) + 1);
+  }
+}
+
+// a parent on tree level l sends to its left child in step 2l and to its
+// right child in step 2l+1
+int BinaryTreeTrafficPattern::_Round(int rank) const
+{
+  int const parent = (rank - 1) / 2;
+  return 2 * log2_floor(parent + 1) + (((rank % 2) == 0) ? 1 : 0);
+}
+
+int BinaryTreeTrafficPattern::_Child(int rank, int step) const
+{
+  int const round = 2 * log2_floor(rank + 1);
+  int const child = (step == round) ? (2 * rank + 1) :
+    ((step == round + 1) ? (2 * rank + 2) : -1);
+  return (child < _ranks) ? child : -1;
+}
+
+int BinaryTreeTrafficPattern::_Parent(int rank, int step) const
+{
+  return ((rank > 0) && (_Round(rank) == step)) ? ((rank - 1) / 2) : -1;
+}
+
+HierarchicalTrafficPattern::HierarchicalTrafficPattern(int nodes, int cube_dim)
+  : SteppedTrafficPattern(nodes), _cube_dim(cube_dim)
+{
+  if((cube_dim < 0) || (_ranks % (1 << cube_dim))) {
+    cout << "Error: Hierarchical collective needs a multiple of 2^hypercubeport ranks." << endl;
+    exit(-1);
+  }
+  _groups = _ranks >> cube_dim;
+  _inter_steps = fold_steps(_groups, log2_floor(_groups));
+  _steps = _cube_dim + _inter_steps + _cube_dim;
+}
+
+int HierarchicalTrafficPattern::_SendTo(int rank, int step) const
+{
+  int const group = rank >> _cube_dim;
+  int const offset = rank & ((1 << _cube_dim) - 1);
+  if(step < _cube_dim) {
+    return rank ^ (1 << (_cube_dim - 1 - step));
+  }
+  step -= _cube_dim;
+  if(step < _inter_steps) {
+    int exchange;
+    int peer = fold_peer(group, _groups, step, log2_floor(_groups), true, exchange);
+    if(exchange >= 0) {
+      peer = group ^ (1 << exchange);
+    }
+    return (peer < 0) ? -1 : ((peer << _cube_dim) | offset);
+  }
+  step -= _inter_steps;
+  return rank ^ (1 << step);
+}
+
+int HierarchicalTrafficPattern::_RecvFrom(int rank, int step) const
+{
+  if((step < _cube_dim) || (step >= _cube_dim + _inter_steps)) {
+    return _SendTo(rank, step);
+  }
+  int const group = rank >> _cube_dim;
+  int const offset = rank & ((1 << _cube_dim) - 1);
+  int exchange;
+  int peer = fold_peer(group, _groups, step - _cube_dim, log2_floor(_groups), false, exchange);
+  if(exchange >= 0) {
+    peer = group ^ (1 << exchange);
+  }
+  return (peer < 0) ? -1 : ((peer << _cube_dim) | offset);
+}
+
+// each router keeps the 1/2^hypercubeport of the vector it reduced inside
+// its hypercube for the exchange between groups
+int HierarchicalTrafficPattern::_Blocks(int step) const
+{
+  if(step < _cube_dim) {
+    return ceil_div(_ranks, 1 << (step + 1));
+  }
+  step -= _cube_dim;
+  if(step < _inter_steps) {
+    return ceil_div(_ranks, 1 << _cube_dim);
+  }
+  step -= _inter_steps;
+  return ceil_div(_ranks, 1 << (_cube_dim - step));
+}
+
 BitRevTrafficPattern::BitRevTrafficPattern(int nodes)
   : BitPermutationTrafficPattern(nodes)
 {
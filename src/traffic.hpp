@@ -41,9 +41,37 @@ protected:
 public:
   virtual ~TrafficPattern() {}
   virtual void reset();
-  virtual int dest(int source) = 0;
+  virtual int dest(int source) = 0;  // 基本の dest は source のみを受け取る
   static TrafficPattern * New(string const & pattern, int nodes, 
 			      Configuration const * const config = NULL);
+  // collective algorithm a pattern runs with: pairwise, ring or none
+  static string Collective(string const & pattern);
+};
+
+// step を使用する特殊なパターン用のインターフェース
+// Collective schedule. The nodes with the same NIC index (all nodes in
+// switch mode) run the schedule among themselves as ranks 0..ranks-1. In
+// each step a rank sends to at most one rank and receives from at most one
+// rank; the router step counters move a NIC to the next step once both are
+// done. Transfers are counted in blocks of collective_threshold packets.
+class SteppedTrafficPattern : public TrafficPattern {
+protected:
+  int _ranks;
+  int _steps;
+  int _Rank(int node) const;
+  int _Node(int rank, int node) const;
+  // rank sent to or received from in a step, -1 if none
+  virtual int _SendTo(int rank, int step) const = 0;
+  virtual int _RecvFrom(int rank, int step) const = 0;
+  virtual int _Blocks(int step) const { return 1; }
+public:
+  SteppedTrafficPattern(int nodes);
+  virtual int dest(int source) override;  // uses the current step of source
+  virtual int dest(int source, int step);  // -1 if source sends nothing
+  int Steps() const { return _steps; }
+  int Node(int router, int nic) const;
+  int TxBlocks(int node, int step) const;
+  int RxBlocks(int node, int step) const;
 };
 
 class PermutationTrafficPattern : public TrafficPattern {
@@ -59,7 +87,7 @@ protected:
 class BitCompTrafficPattern : public BitPermutationTrafficPattern {
 public:
   BitCompTrafficPattern(int nodes);
-  virtual int dest(int source);
+  virtual int dest(int source) override;
 };
 
 class TransposeTrafficPattern : public BitPermutationTrafficPattern {
@@ -67,19 +95,111 @@ protected:
   int _shift;
 public:
   TransposeTrafficPattern(int nodes);
-  virtual int dest(int source);
+  virtual int dest(int source) override;
+};
+
+//class PairwiseTrafficPattern : public SteppedTrafficPattern {
+//public:
+//  PairwiseTrafficPattern(int nodes);
+//  virtual int dest(int source, int step) override;
+//};
+class PairwiseTrafficPattern : public TrafficPattern {
+public:
+  PairwiseTrafficPattern(int nodes);
+  virtual int dest(int source) override;
+};
+class RingTrafficPattern : public TrafficPattern {
+public:
+  RingTrafficPattern(int nodes);
+  virtual int dest(int source) override;
+};
+
+// all-reduce by recursive doubling, the full vector in every step
+class RecursiveDoublingTrafficPattern : public SteppedTrafficPattern {
+protected:
+  virtual int _SendTo(int rank, int step) const override;
+  virtual int _RecvFrom(int rank, int step) const override;
+  virtual int _Blocks(int step) const override;
+public:
+  RecursiveDoublingTrafficPattern(int nodes);
 };
 
+// all-reduce by recursive halving reduce-scatter and recursive doubling
+// all-gather
+class HalvingDoublingTrafficPattern : public SteppedTrafficPattern {
+protected:
+  int _exchanges;
+  virtual int _SendTo(int rank, int step) const override;
+  virtual int _RecvFrom(int rank, int step) const override;
+  virtual int _Blocks(int step) const override;
+public:
+  HalvingDoublingTrafficPattern(int nodes);
+};
+
+// Bruck all-to-all
+class BruckTrafficPattern : public SteppedTrafficPattern {
+protected:
+  virtual int _SendTo(int rank, int step) const override;
+  virtual int _RecvFrom(int rank, int step) const override;
+  virtual int _Blocks(int step) const override;
+public:
+  BruckTrafficPattern(int nodes);
+};
+
+// broadcast from or reduce to rank 0 along a tree; _Child and _Parent
+// describe the broadcast, a reduce runs its steps backwards
+class TreeTrafficPattern : public SteppedTrafficPattern {
+protected:
+  bool _reduce;
+  virtual int _Child(int rank, int step) const = 0;
+  virtual int _Parent(int rank, int step) const = 0;
+  virtual int _SendTo(int rank, int step) const override;
+  virtual int _RecvFrom(int rank, int step) const override;
+  virtual int _Blocks(int step) const override;
+  TreeTrafficPattern(int nodes, bool reduce);
+};
+
+class BinomialTreeTrafficPattern : public TreeTrafficPattern {
+protected:
+  virtual int _Child(int rank, int step) const override;
+  virtual int _Parent(int rank, int step) const override;
+public:
+  BinomialTreeTrafficPattern(int nodes, bool reduce);
+};
+
+class BinaryTreeTrafficPattern : public TreeTrafficPattern {
+protected:
+  int _Round(int rank) const;
+  virtual int _Child(int rank, int step) const override;
+  virtual int _Parent(int rank, int step) const override;
+public:
+  BinaryTreeTrafficPattern(int nodes, bool reduce);
+};
+
+// PolarFly+ all-reduce: reduce-scatter inside each hypercube, recursive
+// doubling between the routers with the same hypercube offset in all
+// groups, then all-gather inside each hypercube
+class HierarchicalTrafficPattern : public SteppedTrafficPattern {
+protected:
+  int _cube_dim;
+  int _groups;
+  int _inter_steps;
+  virtual int _SendTo(int rank, int step) const override;
+  virtual int _RecvFrom(int rank, int step) const override;
+  virtual int _Blocks(int step) const override;
+public:
+  HierarchicalTrafficPattern(int nodes, int cube_dim);
+};
 class BitRevTrafficPattern : public BitPermutationTrafficPattern {
 public:
   BitRevTrafficPattern(int nodes);
-  virtual int dest(int source);
+  virtual int dest(int source) override;
 };
 
 class ShuffleTrafficPattern : public BitPermutationTrafficPattern {
 public:
   ShuffleTrafficPattern(int nodes);
-  virtual int dest(int source);
+  virtual int dest(int source) override;
 };
 
 class DigitPermutationTrafficPattern : public PermutationTrafficPattern {
@@ -35,24 +35,40 @@
 #include "booksim_config.hpp"
 #include "trafficmanager.hpp"
 #include "batchtrafficmanager.hpp"
+#include "flowtrafficmanager.hpp"
+#include "collectivetrafficmanager.hpp"
 #include "random_utils.hpp" 
 #include "vc.hpp"
 #include "packet_reply_info.hpp"
 #include "polarfly_tables.hpp"
-int Hypercube_port;
-int Polarfly_port;
+#include "collective.hpp"
+#include "event_trace.hpp"
+
+int Hypercube_port; // for PolarFly+
+int Polarfly_port; //for PolarFly+
+int numnic;
+int delay_threshold;
+
 TrafficManager * TrafficManager::New(Configuration const & config,
                                      vector<Network *> const & net)
 {
-    Hypercube_port = config.GetInt("k");
-    Polarfly_port = config.GetInt("n");
+    Hypercube_port = PolarFlyPlusHypercubePorts(config);
+    Polarfly_port = PolarFlyPlusPolarFlyPorts(config);
+    numnic = config.GetInt("nic");
+    delay_threshold = config.GetInt("delay_threshold");
 
     TrafficManager * result = NULL;
     string sim_type = config.GetStr("sim_type");
     if((sim_type == "latency") || (sim_type == "throughput")) {
-        result = new TrafficManager(config, net);
+        if(gCollective == COLLECTIVE_NONE) {
+            result = new TrafficManager(config, net);
+        } else {
+            result = new CollectiveTrafficManager(config, net);
+        }
     } else if(sim_type == "batch") {
         result = new BatchTrafficManager(config, net);
+    } else if(sim_type == "flow") {
+        result = new FlowTrafficManager(config, net);
     } else {
         cerr << "Unknown simulation type: " << sim_type << endl;
     } 
@@ -60,11 +76,22 @@ TrafficManager * TrafficManager::New(Configuration const & config,
 }
 
 TrafficManager::TrafficManager( const Configuration &config, const vector<Network *> & net )
-    : Module( 0, "traffic_manager" ), _net(net), _empty_network(false), _deadlock_timer(0), _reset_time(0), _drain_time(-1), _cur_id(0), _cur_pid(0), _time(0)
+    : Module( 0, "traffic_manager" ), _net(net), _reset_qtime(false), _empty_network(false), _deadlock_timer(0), _reset_time(0), _drain_time(-1), _cur_id(0), _cur_pid(0), _time(0)
 {
 
     _nodes = _net[0]->NumNodes( );
     _routers = _net[0]->NumRouters( );
+    // only topologies with fault support size the fault flags
+    if ( (int)fault_nodes.size() < _nodes ) {
+      fault_nodes.resize(_nodes, false);
+    }
+    if ( gCollective != COLLECTIVE_NONE ) {
+      // the start delays are drawn before the simulation seed is set below
+      ResizeCollectiveTables( _routers, _nodes, numnic );
+      for (int i = 0 ; i < _nodes; i++) {
+        delay_table[i] = RandomInt(delay_threshold - 1);
+      }
+    }
 
     _vcs = config.GetInt("num_vcs");
     _subnets = config.GetInt("subnets");
@@ -286,6 +313,7 @@ TrafficManager::TrafficManager( const Configuration &config, const vector<Networ
     _total_in_flight_flits.resize(_classes);
     _measured_in_flight_flits.resize(_classes);
     _retired_packets.resize(_classes);
+    _eject_queue.resize(_subnets);
 
     _packet_seq_no.resize(_nodes);
     _repliesPending.resize(_nodes);
@@ -293,6 +321,25 @@ TrafficManager::TrafficManager( const Configuration &config, const vector<Networ
 
     _hold_switch_for_packet = config.GetInt("hold_switch_for_packet");
 
+    // the body of a packet is sent as trains of up to flit_train flits; a
+    // train needs room for all of its flits, and only the input-queued
+    // router knows how to forward one
+    _flit_train = config.GetInt("flit_train");
+    if(_flit_train > 1) {
+        if(config.GetStr("router") != "iq") {
+            Error("flit_train requires the iq router.");
+        }
+        if(_hold_switch_for_packet || (config.GetInt("sim_count") > 1)) {
+            Error("flit_train does not support hold_switch_for_packet or sim_count > 1.");
+        }
+        if(_flit_train > _buf_states[0][0]->LimitFor(0)) {
+            Error("flit_train is larger than the VC buffers.");
+        }
+    } else {
+        _flit_train = 0;
+    }
+    _inject_free.resize(_nodes, vector<int>(_subnets, 0));
+
     // ============ Simulation parameters ============ 
 
     _total_sims = config.GetInt( "sim_count" );
@@ -311,12 +358,31 @@ TrafficManager::TrafficManager( const Configuration &config, const vector<Networ
       seed = config.GetInt("seed");
     }
     RandomSeed(seed);
+    if(gRandomStreams) {
+      _random.Seed(seed, RandomStream::traffic_manager, 0);
+      _traffic_random.resize(_classes * _nodes);
+      for(int i = 0; i < _classes * _nodes; ++i) {
+        _traffic_random[i].Seed(seed, RandomStream::traffic, i);
+      }
+      for(int c = 0; c < _classes; ++c) {
+        _injection_process[c]->Seed(seed, c);
+      }
+      int index = 0;
+      for(int i = 0; i < _subnets; ++i) {
+        for(size_t r = 0; r < _router[i].size(); ++r) {
+          _router[i][r]->SeedRandom(seed, index++);
+        }
+      }
+    }
 
     _measure_latency = (config.GetStr("sim_type") == "latency");
 
     _sample_period = config.GetInt( "sample_period" );
     _max_samples    = config.GetInt( "max_samples" );
     _warmup_periods = config.GetInt( "warmup_periods" );
+    _converged_periods = 3;
+    _drain_check_period = 1000;
+    _drain_limit = 0;
 
     _measure_stats = config.GetIntArray( "measure_stats" );
     if(_measure_stats.empty()) {
@@ -655,11 +721,9 @@ void TrafficManager::_RetireFlit( Flit *f, int dest )
                    << ", hops = " << f->hops
                    << ", flat = " << f->atime - f->itime
                    << ")." << endl; 
-    assert(_total_in_flight_flits[f->cl].count(f->id) > 0);
-    _total_in_flight_flits[f->cl].erase(f->id);
+    _total_in_flight_flits[f->cl].Remove(f->id);
     if(f->record) {
-        assert(_measured_in_flight_flits[f->cl].count(f->id) > 0);
-        _measured_in_flight_flits[f->cl].erase(f->id);
+        _measured_in_flight_flits[f->cl].Remove(f->id);
     }
     if ( f->watch ) { 
         *gWatchOut << GetSimTime() << " | "
@@ -692,10 +756,7 @@ void TrafficManager::_RetireFlit( Flit *f, int dest )
         if(f->head) {
             head = f;
         } else {
-            map<int, Flit *>::iterator iter = _retired_packets[f->cl].find(f->pid);
-            assert(iter != _retired_packets[f->cl].end());
-            head = iter->second;
-            _retired_packets[f->cl].erase(iter);
+            head = _retired_packets[f->cl].Remove(f->pid);
             assert(head->head);
             assert(f->pid == head->pid);
         }
@@ -754,7 +815,7 @@ void TrafficManager::_RetireFlit( Flit *f, int dest )
     }
   
     if(f->head && !f->tail) {
-        _retired_packets[f->cl].insert(make_pair(f->pid, f));
+        _retired_packets[f->cl].Insert(f->pid, f);
     } else {
         f->Free();
     }
@@ -795,14 +856,20 @@ int TrafficManager::_IssuePacket( int source, int cl )
 void TrafficManager::_GeneratePacket( int source, int stype, 
                                       int cl, int time )
 {  
+    int nodeid = source / numnic;
+    int nicno = source % numnic;
     assert(stype!=0);
     Flit::FlitType packet_type = Flit::ANY_TYPE;
     int size = _GetNextPacketSize(cl); //input size 
+    int packet_destination;
+    {
+      RandomStreamScope scope(gRandomStreams ? &_traffic_random[cl * _nodes + source] : NULL);
+      packet_destination = _traffic_pattern[cl]->dest(source);
+    }
+    if (fault_nodes[nodeid]){return;}
+    if (fault_nodes[packet_destination/numnic]){return;}
     int pid = _cur_pid++;
     assert(_cur_pid);
-    int packet_destination = _traffic_pattern[cl]->dest(source);
-    if (fault_nodes[source]){return;}
-    if (fault_nodes[packet_destination]){return;}
 #ifdef PFP_DEBUG
     cout << "TrafficManager GeneratePacket id:" << pid << " source:" << source << " type:" << stype << " class:" << cl << " time:" << time << " dest:" << packet_destination << endl;
 #endif
@@ -866,10 +933,17 @@ void TrafficManager::_GeneratePacket( int source, int stype,
                    << "." << endl;
     }
   
-    for ( int i = 0; i < size; ++i ) {
+    int train = 1;
+    for ( int i = 0; i < size; i += train ) {
+        // head and tail are single flits, the body in between is cut into
+        // trains that keep the flit ids of the flits they stand for
+        train = ( _flit_train && ( i > 0 ) && ( i < size - 1 ) ) ?
+            min( _flit_train, size - 1 - i ) : 1;
         Flit * f  = Flit::New();
-        f->id     = _cur_id++;
-        assert(_cur_id);
+        f->id     = _cur_id;
+        f->train  = train;
+        _cur_id  += train;
+        assert(_cur_id > 0);
         f->pid    = pid;
         f->watch  = watch | (gWatchOut && (_flits_to_watch.count(f->id) > 0));
         f->subnetwork = subnetwork;
@@ -877,10 +951,12 @@ void TrafficManager::_GeneratePacket( int source, int stype,
         f->ctime  = time;
         f->record = record;
         f->cl     = cl;
-	f->data = (int*)malloc(sizeof(int)*5);//for source routing
-	_total_in_flight_flits[f->cl].insert(make_pair(f->id, f));
+        if ( gCollective != COLLECTIVE_NONE ) {
+            f->step = gSingleSwitch ? step_table[0][nodeid] : step_table[nodeid][nicno];
+        }
+	_total_in_flight_flits[f->cl].Insert(f->id, f);
         if(record) {
-            _measured_in_flight_flits[f->cl].insert(make_pair(f->id, f));
+            _measured_in_flight_flits[f->cl].Insert(f->id, f);
         }
     
         if(gTrace){
@@ -917,6 +993,9 @@ void TrafficManager::_GeneratePacket( int source, int stype,
         } else {
             f->tail = false;
         }
+        if ( gEventTrace && f->head ) {
+            gEventTrace->RecordCreate(f);
+        }
     
         f->vc  = -1;
 
@@ -933,13 +1012,13 @@ void TrafficManager::_GeneratePacket( int source, int stype,
     }
 }
 
-void TrafficManager::_Inject(){
-
-    for ( int input = 0; input < _nodes; ++input ) {
-        for ( int c = 0; c < _classes; ++c ) {
+// Potentially generates packets for any class of an input whose injection
+// queue is currently empty.
+void TrafficManager::_InjectInput( int input )
+{
+	for ( int c = 0; c < _classes; ++c ){
             // Potentially generate packets for any (input,class)
-            // that is currently empty
-	
+            // that is currently empty	
             if ( _partial_packets[input][c].empty() ) {
                 bool generated = false;
                 while( !generated && ( _qtime[input][c] <= _time ) ) {
@@ -956,16 +1035,31 @@ void TrafficManager::_Inject(){
                         ++_qtime[input][c];
                     }
                 }
-	
                 if ( ( _sim_state == draining ) && 
                      ( _qtime[input][c] > _drain_time ) ) {
                     _qdrained[input][c] = true;
                 }
+		
+		if ( _reset_qtime ) {
+		    _qtime[input][c]=0;//timer reset
+		}
             }
         }
+}
+
+void TrafficManager::_Inject(){	
+    for ( int input = 0; input < _nodes; ++input ) {
+        _InjectInput( input );
     }
 }
 
+// Without a collective gating the injection, packet generation draws random
+// numbers every cycle, so no cycle can be skipped.
+int TrafficManager::_FastForward( int max_cycles )
+{
+    return 0;
+}
+
 void TrafficManager::_Step( )
 {
     bool flits_in_flight = false;
@@ -977,7 +1071,6 @@ void TrafficManager::_Step( )
         cout << "WARNING: Possible network deadlock.\n";
     }
 
-    vector<map<int, Flit *> > flits(_subnets);
 #ifdef PFP_DEBUG
     cout << "TrafficManager Step() sim state " << _sim_state << endl;
 #endif
@@ -994,9 +1087,9 @@ void TrafficManager::_Step( )
                                << "." << endl;
                 }
 
-		flits[subnet].insert(make_pair(n, f));
+		_eject_queue[subnet].push_back(make_pair(n, f));
                 if((_sim_state == warming_up) || (_sim_state == running)) {
-                    ++_accepted_flits[f->cl][n];
+                    _accepted_flits[f->cl][n] += f->train;
                     if(f->tail) {
                         ++_accepted_packets[f->cl][n];
                     }
@@ -1005,8 +1098,7 @@ void TrafficManager::_Step( )
             Credit * const c = _net[subnet]->ReadCredit( n );
             if ( c ) {
 #ifdef TRACK_FLOWS
-                for(set<int>::const_iterator iter = c->vc.begin(); iter != c->vc.end(); ++iter) {
-                    int const vc = *iter;
+                for(int vc = c->vc.First(); vc >= 0; vc = c->vc.Next(vc)) {
                     assert(!_outstanding_classes[n][subnet][vc].empty());
                     int cl = _outstanding_classes[n][subnet][vc].front();
                     _outstanding_classes[n][subnet][vc].pop();
@@ -1025,6 +1117,11 @@ void TrafficManager::_Step( )
     }
     for(int subnet = 0; subnet < _subnets; ++subnet) {
         for(int n = 0; n < _nodes; ++n) {
+
+            // a train keeps the injection channel busy for all of its flits
+            if(_flit_train && (_time < _inject_free[n][subnet])) {
+                continue;
+            }
             
             Flit * f = NULL;
 
@@ -1036,7 +1133,7 @@ void TrafficManager::_Step( )
             if(_hold_switch_for_packet) {
                 list<Flit *> const & pp = _partial_packets[n][last_class];
                 if(!pp.empty() && !pp.front()->head && 
-                   !dest_buf->IsFullFor(pp.front()->vc)) {
+                   !dest_buf->IsFullFor(pp.front()->vc, pp.front())) {
                     f = pp.front();
                     assert(f->vc == _last_vc[n][subnet][last_class]);
 
@@ -1069,7 +1166,7 @@ void TrafficManager::_Step( )
                 if(cf->head && cf->vc == -1) { // Find first available VC
                     OutputSet route_set;
                     _rf(NULL, cf, -1, &route_set, true); //( const Router *r, const Flit *f, int in_channel,OutputSet *outputs, bool inject )
-		    set<OutputSet::sSetElement> const & os = route_set.GetSet();
+		    OutputSet const & os = route_set.GetSet();
                     assert(os.size() == 1);
                     OutputSet::sSetElement const & se = *os.begin();
                     assert(se.output_port == -1);
@@ -1095,7 +1192,7 @@ void TrafficManager::_Step( )
                                        << "Generating lookahead routing info for flit " << cf->id
                                        << " (NOQ)." << endl;
                         }
-                        set<OutputSet::sSetElement> const sl = cf->la_route_set.GetSet();
+                        OutputSet const & sl = cf->la_route_set.GetSet();
                         assert(sl.size() == 1);
                         int next_output = sl.begin()->output_port;
                         vc_count /= router->NumOutputs();
@@ -1147,7 +1244,7 @@ void TrafficManager::_Step( )
                                    << "." << endl;
                     }
                 } else {
-                    if(dest_buf->IsFullFor(cf->vc)) {
+                    if(dest_buf->IsFullFor(cf->vc, cf)) {
                         if(cf->watch) {
                             *gWatchOut << GetSimTime() << " | " << FullName() << " | "
                                        << "Selected output VC " << cf->vc
@@ -1225,7 +1322,7 @@ void TrafficManager::_Step( )
                 }
 	
                 if((_sim_state == warming_up) || (_sim_state == running)) {
-                    ++_sent_flits[c][n];
+                    _sent_flits[c][n] += f->train;
                     if(f->head) {
                         ++_sent_packets[c][n];
                     }
@@ -1235,37 +1332,44 @@ void TrafficManager::_Step( )
                 ++_injected_flits[c][n];
 #endif
 	
+                if(gEventTrace) {
+                    gEventTrace->Record(EventTrace::inject, n, subnet, f, f->dest);
+                }
                 _net[subnet]->WriteFlit(f, n);
+                _inject_free[n][subnet] = _time + f->train;
 	
             }
         }
     }
     for(int subnet = 0; subnet < _subnets; ++subnet) {
-        for(int n = 0; n < _nodes; ++n) {
-            map<int, Flit *>::const_iterator iter = flits[subnet].find(n);
-            if(iter != flits[subnet].end()) {
-                Flit * const f = iter->second;
-                f->atime = _time;
-                if(f->watch) {
-                    *gWatchOut << GetSimTime() << " | "
-                               << "node" << n << " | "
-                               << "Injecting credit for VC " << f->vc 
-                               << " into subnet " << subnet 
-                               << "." << endl;
-                }
-                Credit * const c = Credit::New();
-                c->vc.insert(f->vc);
-                _net[subnet]->WriteCredit(c, n);
+        vector<pair<int, Flit *> > & ejected = _eject_queue[subnet];
+        for(size_t i = 0; i < ejected.size(); ++i) {
+            int const n = ejected[i].first;
+            Flit * const f = ejected[i].second;
+            f->atime = _time;
+            if(f->watch) {
+                *gWatchOut << GetSimTime() << " | "
+                           << "node" << n << " | "
+                           << "Injecting credit for VC " << f->vc 
+                           << " into subnet " << subnet 
+                           << "." << endl;
+            }
+            if(gEventTrace) {
+                gEventTrace->Record(EventTrace::eject, n, subnet, f, f->hops);
+            }
+            Credit * const c = Credit::New();
+            c->vc.insert(f->vc);
+            c->train = f->train;
+            _net[subnet]->WriteCredit(c, n);
 #ifdef TRACK_FLOWS
-                ++_ejected_flits[f->cl][n];
+            ++_ejected_flits[f->cl][n];
 #endif
 #ifdef PFP_DEBUG
-                cout << "TrafficManager Step() Inject RetireFlit id:"<< f->pid << " f->src:" << f->src << " f->dest:" << f->dest << " dest:" << n << " VC:" << f->vc << endl;	
+            cout << "TrafficManager Step() Inject RetireFlit id:"<< f->pid << " f->src:" << f->src << " f->dest:" << f->dest << " dest:" << n << " VC:" << f->vc << endl;	
 #endif
 		_RetireFlit(f, n);
-            }
         }
-        flits[subnet].clear();
+        ejected.clear();
         _net[subnet]->Evaluate( );
         _net[subnet]->WriteOutputs( );
     }
@@ -1388,16 +1492,15 @@ void TrafficManager::_DisplayRemaining( ostream & os ) const
 {
     for(int c = 0; c < _classes; ++c) {
 
-        map<int, Flit *>::const_iterator iter;
-        int i;
+        int id, i;
 
         os << "Class " << c << ":" << endl;
 
         os << "Remaining flits: ";
-        for ( iter = _total_in_flight_flits[c].begin( ), i = 0;
-              ( iter != _total_in_flight_flits[c].end( ) ) && ( i < 10 );
-              iter++, i++ ) {
-            os << iter->first << " ";
+        for ( id = _total_in_flight_flits[c].First( ), i = 0;
+              ( id >= 0 ) && ( i < 10 );
+              id = _total_in_flight_flits[c].Next( id ), i++ ) {
+            os << id << " ";
         }
         if(_total_in_flight_flits[c].size() > 10)
             os << "[...] ";
@@ -1405,10 +1508,10 @@ void TrafficManager::_DisplayRemaining( ostream & os ) const
         os << "(" << _total_in_flight_flits[c].size() << " flits)" << endl;
     
         os << "Measured flits: ";
-        for ( iter = _measured_in_flight_flits[c].begin( ), i = 0;
-              ( iter != _measured_in_flight_flits[c].end( ) ) && ( i < 10 );
-              iter++, i++ ) {
-            os << iter->first << " ";
+        for ( id = _measured_in_flight_flits[c].First( ), i = 0;
+              ( id >= 0 ) && ( i < 10 );
+              id = _measured_in_flight_flits[c].Next( id ), i++ ) {
+            os << id << " ";
         }
         if(_measured_in_flight_flits[c].size() > 10)
             os << "[...] ";
@@ -1422,14 +1525,15 @@ bool TrafficManager::_SingleSim( )
 {
     int converged = 0;
   
-    //once warmed up, we require 3 converging runs to end the simulation 
+    //once warmed up, we require _converged_periods converging runs to end
+    //the simulation
     vector<double> prev_latency(_classes, 0.0);
     vector<double> prev_accepted(_classes, 0.0);
     bool clear_last = false;
     int total_phases = 0;
     while( ( total_phases < _max_samples ) && 
            ( ( _sim_state != running ) || 
-             ( converged < 3 ) ) ) {
+             ( converged < _converged_periods ) ) ) {
     
         if ( clear_last || (( ( _sim_state == warming_up ) && ( ( total_phases % 2 ) == 0 ) )) ) {
             clear_last = false;
@@ -1443,6 +1547,7 @@ bool TrafficManager::_SingleSim( )
 	       cout << "TrafficManager SingleSim() step" << iter << endl;	
 #endif
 	       _Step( );
+	       iter += _FastForward( _sample_period - iter - 1 );
 	}
     
         //cout << _sim_state << endl;
@@ -1476,13 +1581,8 @@ bool TrafficManager::_SingleSim( )
             double latency = (double)_plat_stats[c]->Sum();
             double count = (double)_plat_stats[c]->NumSamples();
       
-            map<int, Flit *>::const_iterator iter;
-            for(iter = _total_in_flight_flits[c].begin(); 
-                iter != _total_in_flight_flits[c].end(); 
-                iter++) {
-                latency += (double)(_time - iter->second->ctime);
-                count++;
-            }
+            latency += (double)_total_in_flight_flits[c].AgeSum(_time);
+            count += (double)_total_in_flight_flits[c].size();
       
             if((lat_exc_class < 0) &&
                (_latency_thres[c] >= 0.0) &&
@@ -1561,12 +1661,13 @@ bool TrafficManager::_SingleSim( )
         if ( _measure_latency ) {
             cout << "Draining all recorded packets ..." << endl;
             int empty_steps = 0;
-            while( _PacketsOutstanding( ) ) { 
+            while( _PacketsOutstanding( ) &&
+                   ( ( _drain_limit <= 0 ) || ( empty_steps < _drain_limit ) ) ) { 
                 _Step( ); 
 	
                 ++empty_steps;
 	
-                if ( empty_steps % 1000 == 0 ) {
+                if ( empty_steps % _drain_check_period == 0 ) {
 	  
                     int lat_exc_class = -1;
 	  
@@ -1581,13 +1682,8 @@ bool TrafficManager::_SingleSim( )
                         double acc_latency = _plat_stats[c]->Sum();
                         double acc_count = (double)_plat_stats[c]->NumSamples();
 	    
-                        map<int, Flit *>::const_iterator iter;
-                        for(iter = _total_in_flight_flits[c].begin(); 
-                            iter != _total_in_flight_flits[c].end(); 
-                            iter++) {
-                            acc_latency += (double)(_time - iter->second->ctime);
-                            acc_count++;
-                        }
+                        acc_latency += (double)_total_in_flight_flits[c].AgeSum(_time);
+                        acc_count += (double)_total_in_flight_flits[c].size();
 	    
                         if((acc_latency / acc_count) > threshold) {
                             lat_exc_class = c;
@@ -1619,6 +1715,7 @@ bool TrafficManager::_SingleSim( )
 
 bool TrafficManager::Run( )
 {
+    RandomStreamScope scope( &_random );
     for ( int sim = 0; sim < _total_sims; ++sim ) {
 
         _time = 0;
@@ -1636,6 +1733,7 @@ bool TrafficManager::Run( )
         for ( int s = 0; s < _nodes; ++s ) {
             _qtime[s].assign(_classes, 0);
             _qdrained[s].assign(_classes, false);
+            _inject_free[s].assign(_subnets, 0);
         }
 
         // warm-up ...
@@ -2182,7 +2280,7 @@ void TrafficManager::DisplayOverallStats( ostream & os ) const {
 #endif
 
 #ifdef PFP_MAP_DEBUG
-    for(int i = 0 ; i < POLARFLY_TABLE_ROWS*(1<<Hypercube_port); i++ ){
+    for(int i = 0 ; i < polarfly_table_rows*(1<<Hypercube_port); i++ ){
      	cout << "##node" << i << " : ";
         for(int j = 0; j <= Hypercube_port + Polarfly_port; j++) {
             int sum =0;
@@ -31,12 +31,14 @@
 #include <list>
 #include <map>
 #include <set>
+#include <queue>
 #include <cassert>
 
 #include "module.hpp"
 #include "config_utils.hpp"
 #include "network.hpp"
 #include "flit.hpp"
+#include "flit_table.hpp"
 #include "buffer_state.hpp"
 #include "stats.hpp"
 #include "traffic.hpp"
@@ -86,6 +88,11 @@ protected:
   vector<TrafficPattern *> _traffic_pattern;
   vector<InjectionProcess *> _injection_process;
 
+  // with rng = stream: the stream of the traffic manager itself and one
+  // stream per class and source for the destinations of the traffic patterns
+  RandomStream _random;
+  vector<RandomStream> _traffic_random;
+
   // ============ Message priorities ============ 
 
   enum ePriority { class_based, age_based, network_age_based, local_age_based, queue_length_based, hop_count_based, sequence_based, none };
@@ -112,14 +119,27 @@ protected:
   vector<vector<int> > _qtime;
   vector<vector<bool> > _qdrained;
   vector<vector<list<Flit *> > > _partial_packets;
-
-  vector<map<int, Flit *> > _total_in_flight_flits;
-  vector<map<int, Flit *> > _measured_in_flight_flits;
-  vector<map<int, Flit *> > _retired_packets;
+  // test the injection process once per cycle instead of catching up on
+  // the cycles an input did not inject in
+  bool _reset_qtime;
+
+  vector<FlitTable> _total_in_flight_flits;
+  vector<FlitTable> _measured_in_flight_flits;
+  // head flits of packets whose tail has not arrived, indexed by packet id
+  vector<FlitTable> _retired_packets;
+  // flits ejected in the current cycle per subnet, in node order; the
+  // vectors are reused across cycles
+  vector<vector<pair<int, Flit *> > > _eject_queue;
   bool _empty_network;
 
   bool _hold_switch_for_packet;
 
+  // longest train of body flits represented by one Flit, 0 if off
+  int _flit_train;
+  // per node and subnet, the first cycle in which the injection channel
+  // is done with the last train
+  vector<vector<int> > _inject_free;
+
   // ============ physical sub-networks ==========
 
   int _subnets;
@@ -215,6 +235,13 @@ protected:
   int   _sample_period;
   int   _max_samples;
   int   _warmup_periods;
+  // sample periods in a row that have to converge to end the simulation
+  int   _converged_periods;
+
+  // draining checks the latency every _drain_check_period cycles and gives
+  // up after _drain_limit cycles (0: never)
+  int   _drain_check_period;
+  int   _drain_limit;
 
   int   _include_queuing;
 
@@ -264,13 +291,15 @@ protected:
 
   virtual void _RetireFlit( Flit *f, int dest );
 
-  void _Inject();
+  void _InjectInput( int input );
+  virtual void _Inject();
   void _Step( );
+  virtual int _FastForward( int max_cycles );
 
   bool _PacketsOutstanding( ) const;
   
   virtual int  _IssuePacket( int source, int cl );
-  void _GeneratePacket( int source, int size, int cl, int time );
+  virtual void _GeneratePacket( int source, int size, int cl, int time );
 
   virtual void _ClearStats( );
 
@@ -48,7 +48,7 @@ const char * const VC::VCSTATE[] = {"idle",
 VC::VC( const Configuration& config, int outputs, 
 	Module *parent, const string& name )
   : Module( parent, name ), 
-    _state(idle), _out_port(-1), _out_vc(-1), _pri(0), _watched(false), 
+    _flits(0), _state(idle), _out_port(-1), _out_vc(-1), _pri(0), _watched(false), 
     _expected_pid(-1), _last_id(-1), _last_pid(-1)
 {
   _lookahead_routing = !config.GetInt("routing_delay");
@@ -104,6 +104,7 @@ void VC::AddFlit( Flit *f )
   }
 
   _buffer.push_back(f);
+  _flits += f->train;
   UpdatePriority();
 }
 
@@ -113,6 +114,7 @@ Flit *VC::RemoveFlit( )
   if ( !_buffer.empty( ) ) {
     f = _buffer.front( );
     _buffer.pop_front( );
+    _flits -= f->train;
     _last_id = f->id;
     _last_pid = f->pid;
     UpdatePriority();
@@ -158,7 +160,7 @@ void VC::UpdatePriority()
 {
   if(_buffer.empty()) return;
   if(_pri_type == queue_length_based) {
-    _pri = _buffer.size();
+    _pri = _flits;
   } else if(_pri_type != none) {
     Flit * f = _buffer.front();
     if((_pri_type != local_age_based) && _priority_donation) {
@@ -213,7 +215,7 @@ void VC::Display( ostream & os ) const
       os << " out_port: " << _out_port
 	 << " out_vc: " << _out_vc;
     }
-    os << " fill: " << _buffer.size();
+    os << " fill: " << _flits;
     if(!_buffer.empty()) {
       os << " front: " << _buffer.front()->id;
     }
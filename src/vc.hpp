@@ -28,9 +28,8 @@
 #ifndef _VC_HPP_
 #define _VC_HPP_
 
-#include <deque>
-
 #include "flit.hpp"
+#include "ringbuffer.hpp"
 #include "outputset.hpp"
 #include "routefunc.hpp"
 #include "config_utils.hpp"
@@ -46,7 +45,9 @@ public:
   
 private:
 
-  deque<Flit *> _buffer;
+  RingBuffer<Flit *> _buffer;
+  // flits in the buffer; a train stands for several flits in one entry
+  int _flits;
   
   eVCState _state;
   
@@ -124,7 +125,7 @@ public:
 
   inline int GetOccupancy() const
   {
-    return (int)_buffer.size();
+    return _flits;
   }
 
   // ==== Debug functions ====
@@ -1,68 +0,0 @@
-// $Id$
-
-/*
- Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
- All rights reserved.
-
- Redistribution and use in source and binary forms, with or without
- modification, are permitted provided that the following conditions are met:
-
- Redistributions of source code must retain the above copyright notice, this 
- list of conditions and the following disclaimer.
- Redistributions in binary form must reproduce the above copyright notice, this
- list of conditions and the following disclaimer in the documentation and/or
- other materials provided with the distribution.
-
- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
- ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
- WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
- DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
- ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
- (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
- LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
- ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
- (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
- SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-*/
-
-#ifndef _PRIO_ARB_HPP_
-#define _PRIO_ARB_HPP_
-
-#include <list>
-
-#include "module.hpp"
-#include "config_utils.hpp"
-
-class PriorityArbiter : public Module {
-  int _rr_ptr;
-
-protected:
-  const int _inputs;
-
-  struct sRequest {
-    int in;
-    int label;
-    int pri;
-  };
-
-  list<sRequest> _requests;
-
-  int _match;
-
-public:
-  PriorityArbiter( const Configuration &config,
-		   Module *parent, const string& name,
-		   int inputs );
-
-  void Clear( );
-
-  void AddRequest( int in, int label = 0, int pri = 0 );
-  void RemoveRequest( int in, int label = 0 );
-
-  int Match( ) const;
-
-  void Arbitrate( );
-  void Update( );
-};
-
-#endif 
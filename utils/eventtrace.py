@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+# Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+# Reader for the binary flit event trace written with event_trace_out.
+#
+# usage: eventtrace.py [--text] <trace file>
+#
+# --text prints one event per line, in time order. Without it, the
+# per-packet latency breakdown is printed: the queuing delay at the source
+# (create to inject), the network latency of the head flit (inject to
+# eject), its hop count and the average time it spends in a router
+# (arrive to switch traversal).
+
+import struct
+import sys
+
+MAGIC = b'BSEVTRC1'
+RECORD = struct.Struct('<iiiiihhB3x')
+TYPES = ['create', 'inject', 'arrive', 'route', 'vc_grant', 'sw_traverse',
+         'eject', 'credit', 'step_tx', 'step_rx']
+
+
+def read_events(name):
+    with open(name, 'rb') as f:
+        data = f.read()
+    if data[:8] != MAGIC:
+        sys.exit('%s: not an event trace' % name)
+    size, _ = struct.unpack_from('<II', data, 8)
+    if size != RECORD.size:
+        sys.exit('%s: record size %d, expected %d' % (name, size, RECORD.size))
+    events = [RECORD.unpack_from(data, off)
+              for off in range(16, len(data) - size + 1, size)]
+    # the records of different threads are interleaved in blocks
+    events.sort(key=lambda e: e[0])
+    return events
+
+
+def print_text(events):
+    print('time type id pid where port vc aux')
+    for (time, fid, pid, where, aux, port, vc, etype) in events:
+        print(time, TYPES[etype], fid, pid, where, port, vc, aux)
+
+
+def print_latency(events):
+    packets = {}
+    routers = {}
+    for (time, fid, pid, where, aux, port, vc, etype) in events:
+        name = TYPES[etype]
+        if name == 'create':
+            packets[fid] = {'pid': pid, 'src': where, 'dest': aux,
+                            'create': time, 'router': 0, 'visits': 0}
+        elif fid not in packets:
+            continue
+        elif name in ('inject', 'eject'):
+            packets[fid][name] = time
+            if name == 'eject':
+                packets[fid]['hops'] = aux
+        elif name == 'arrive':
+            routers[fid] = time
+        elif name == 'sw_traverse' and fid in routers:
+            packets[fid]['router'] += time - routers.pop(fid)
+            packets[fid]['visits'] += 1
+    print('pid src dest queuing network hops router_avg')
+    total = [0, 0, 0]
+    for fid in sorted(packets, key=lambda i: packets[i]['pid']):
+        p = packets[fid]
+        if 'eject' not in p:
+            continue
+        queuing = p['inject'] - p['create']
+        network = p['eject'] - p['inject']
+        router = float(p['router']) / p['visits'] if p['visits'] else 0.0
+        print(p['pid'], p['src'], p['dest'], queuing, network, p['hops'],
+              '%.2f' % router)
+        total[0] += 1
+        total[1] += queuing
+        total[2] += network
+    if total[0]:
+        print('# packets %d, average queuing %.2f, average network %.2f' %
+              (total[0], float(total[1]) / total[0], float(total[2]) / total[0]))
+
+
+def main(args):
+    text = '--text' in args
+    args = [a for a in args if a != '--text']
+    if len(args) != 1:
+        sys.exit('usage: eventtrace.py [--text] <trace file>')
+    events = read_events(args[0])
+    if text:
+        print_text(events)
+    else:
+        print_latency(events)
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
@@ -0,0 +1,87 @@
+#!/bin/sh
+
+# $Id$
+
+# Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+# Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+# Compares the cost of simulating one router for one cycle between two
+# booksim binaries, e.g. a build before and after a change to the router
+# pipeline. Both binaries run the same configuration a number of times and
+# the best run of each is kept.
+#
+# Example:
+#
+#  ./router_bench.sh old/booksim ../src/booksim ../runfiles/meshconfig 64 3
+#
+# The number of routers of the configured network is given on the command
+# line. The script prints the run time, the simulated cycles and the time
+# per router and cycle of both binaries. Channels and the traffic manager
+# are included in the time, so the figures are an upper bound for the
+# router alone.
+
+if [ $# -lt 4 ]
+then
+    echo "usage: ${0} <booksim_before> <booksim_after> <config> <routers> [runs]"
+    exit 1
+fi
+
+before=${1}
+after=${2}
+config=${3}
+routers=${4}
+runs=${5:-3}
+
+log=`mktemp`
+trap 'rm -f ${log}' EXIT
+
+run() {
+    best=""
+    for i in `seq ${runs}`
+    do
+        ${1} ${config} > ${log} 2>&1
+        seconds=`grep "Total run time" ${log} | tail -1 | awk '{ print $4 }'`
+        cycles=`grep "Time taken is" ${log} | awk '{ sum += $4 } END { print sum }'`
+        if [ "${seconds}" = "" ] || [ "${cycles}" = "" ]
+        then
+            grep "Error" ${log}
+            echo "BENCH: Simulation run failed."
+            exit 1
+        fi
+        if [ "${best}" = "" ] || [ `awk "BEGIN { print (${seconds} < ${best}) }"` = 1 ]
+        then
+            best=${seconds}
+        fi
+    done
+    ns=`awk "BEGIN { printf \"%.1f\", 1e9 * ${best} / (${cycles} * ${routers}) }"`
+}
+
+run ${before}
+before_ns=${ns}
+echo "BENCH: before: ${best}s, ${cycles} cycles, ${ns} ns per router-cycle"
+
+run ${after}
+echo "BENCH: after:  ${best}s, ${cycles} cycles, ${ns} ns per router-cycle"
+
+awk "BEGIN { printf \"BENCH: difference: %+.1f%%\n\", 100 * (${ns} - ${before_ns}) / ${before_ns} }"
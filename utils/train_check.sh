@@ -0,0 +1,87 @@
+#!/bin/sh
+
+# $Id$
+
+# Copyright (c) 2007-2015, Trustees of The Leland Stanford Junior University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+# Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+# Compares the flit train model (flit_train) against the full flit-level
+# model on one configuration. Both runs use the given packet size with an
+# injection rate of 1 / packet_size, as the collective examples do.
+#
+# Example:
+#
+#  ./train_check.sh ../src/booksim ../src/examples/polarflyplus_collective 1024 64
+#
+# The script prints the completion time and the average packet latency of
+# both runs, the relative difference of the train model and the wall-clock
+# time of each run.
+
+if [ $# -lt 3 ]
+then
+    echo "usage: ${0} <booksim> <config> <packet_size> [flit_train]"
+    exit 1
+fi
+
+sim=${1}
+config=${2}
+size=${3}
+train=${4:-$((size - 2))}
+rate=`awk "BEGIN { print 1 / ${size} }"`
+
+cfg=`mktemp`
+log=`mktemp`
+trap 'rm -f ${cfg} ${log}' EXIT
+
+run() {
+    # later assignments in the file override the earlier ones; flit trains
+    # run a single simulation
+    cat ${config} > ${cfg}
+    echo "" >> ${cfg}
+    echo "packet_size = ${size}; injection_rate = ${rate}; flit_train = ${1}; sim_count = 1;" >> ${cfg}
+    start=`date +%s`
+    ${sim} ${cfg} > ${log} 2>&1
+    end=`date +%s`
+    cycles=`grep "Time taken is" ${log} | tail -1 | awk '{ print $4 }'`
+    latency=`grep "Packet latency average" ${log} | tail -1 | awk '{ print $5 }'`
+    if [ "${cycles}" = "" ]
+    then
+        grep "Error" ${log}
+        echo "TRAIN: Simulation run failed."
+        exit 1
+    fi
+    seconds=$((end - start))
+}
+
+run 0
+full_cycles=${cycles}
+full_latency=${latency}
+echo "TRAIN: full model:   ${full_cycles} cycles, packet latency ${full_latency}, ${seconds}s"
+
+run ${train}
+echo "TRAIN: flit_train=${train}: ${cycles} cycles, packet latency ${latency}, ${seconds}s"
+
+awk "BEGIN { printf \"TRAIN: difference:   %+.2f%% cycles, %+.2f%% packet latency\n\", \
+    100 * (${cycles} - ${full_cycles}) / ${full_cycles}, \
+    100 * (${latency} - ${full_latency}) / ${full_latency} }"